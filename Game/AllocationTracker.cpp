@@ -0,0 +1,228 @@
+#include "Game/AllocationTracker.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+thread_local AllocationTag g_currentAllocationTag = AllocationTag::UNTAGGED;
+
+
+//constants
+constexpr int NUM_ALLOCATION_TAGS = static_cast<int>(AllocationTag::COUNT);
+constexpr size_t ALLOCATION_HEADER_SIZE = 16;	//keeps the block after the header as aligned as malloc's
+
+
+//written in front of every tracked block
+struct AllocationHeader
+{
+	size_t		  m_size = 0;
+	AllocationTag m_tag = AllocationTag::UNTAGGED;
+};
+static_assert(sizeof(AllocationHeader) <= ALLOCATION_HEADER_SIZE, "AllocationHeader must fit in ALLOCATION_HEADER_SIZE");
+
+
+//any thread can allocate, so the running counts are atomics; relaxed is enough, they're only ever totals
+//zero-initialized before any constructor runs, so allocations made during static initialization are counted too
+static std::atomic<int64_t> s_frameAllocations[NUM_ALLOCATION_TAGS];
+static std::atomic<int64_t> s_frameBytes[NUM_ALLOCATION_TAGS];
+static std::atomic<int64_t> s_liveBytes[NUM_ALLOCATION_TAGS];
+static std::atomic<int64_t> s_framePeakLiveBytes[NUM_ALLOCATION_TAGS];
+
+//only touched by the thread running the frame loop
+static AllocationStats s_lastFrameStats[NUM_ALLOCATION_TAGS];
+static int			   s_budgets[NUM_ALLOCATION_TAGS] = { -1, -1, -1, -1, -1, -1 };
+static int			   s_numBudgetOverruns[NUM_ALLOCATION_TAGS] = {};
+static_assert(NUM_ALLOCATION_TAGS == 6, "s_budgets needs an entry per AllocationTag");
+
+
+//-----------------------------------------------------------------------------------------------
+static void* TrackedAllocate(size_t size)
+{
+	unsigned char* block = static_cast<unsigned char*>(malloc(size + ALLOCATION_HEADER_SIZE));
+	if (block == nullptr)
+	{
+		return nullptr;
+	}
+
+	AllocationTag tag = g_currentAllocationTag;
+	AllocationHeader* header = reinterpret_cast<AllocationHeader*>(block);
+	header->m_size = size;
+	header->m_tag = tag;
+
+	int tagIndex = static_cast<int>(tag);
+	s_frameAllocations[tagIndex].fetch_add(1, std::memory_order_relaxed);
+	s_frameBytes[tagIndex].fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+	int64_t liveBytes = s_liveBytes[tagIndex].fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+
+	int64_t peakLiveBytes = s_framePeakLiveBytes[tagIndex].load(std::memory_order_relaxed);
+	while (liveBytes > peakLiveBytes && !s_framePeakLiveBytes[tagIndex].compare_exchange_weak(peakLiveBytes, liveBytes, std::memory_order_relaxed))
+	{
+	}
+
+	return block + ALLOCATION_HEADER_SIZE;
+}
+
+
+static void TrackedFree(void* memory)
+{
+	if (memory == nullptr)
+	{
+		return;
+	}
+
+	unsigned char* block = static_cast<unsigned char*>(memory) - ALLOCATION_HEADER_SIZE;
+	AllocationHeader const* header = reinterpret_cast<AllocationHeader const*>(block);
+	s_liveBytes[static_cast<int>(header->m_tag)].fetch_sub(static_cast<int64_t>(header->m_size), std::memory_order_relaxed);
+
+	free(block);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//global operator new and delete replacements; the over-aligned (std::align_val_t) forms are left to the standard
+//library, so types with alignas above malloc's alignment are allocated untracked
+void* operator new(size_t size)
+{
+	void* memory = TrackedAllocate(size);
+	if (memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+
+void* operator new[](size_t size)
+{
+	void* memory = TrackedAllocate(size);
+	if (memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+
+void* operator new(size_t size, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocate(size);
+}
+
+
+void* operator new[](size_t size, std::nothrow_t const&) noexcept
+{
+	return TrackedAllocate(size);
+}
+
+
+void operator delete(void* memory) noexcept
+{
+	TrackedFree(memory);
+}
+
+
+void operator delete[](void* memory) noexcept
+{
+	TrackedFree(memory);
+}
+
+
+void operator delete(void* memory, size_t size) noexcept
+{
+	UNUSED(size);
+	TrackedFree(memory);
+}
+
+
+void operator delete[](void* memory, size_t size) noexcept
+{
+	UNUSED(size);
+	TrackedFree(memory);
+}
+
+
+void operator delete(void* memory, std::nothrow_t const&) noexcept
+{
+	TrackedFree(memory);
+}
+
+
+void operator delete[](void* memory, std::nothrow_t const&) noexcept
+{
+	TrackedFree(memory);
+}
+
+
+//
+//frame functions
+//
+void BeginAllocationFrame()
+{
+	for (int tagIndex = 0; tagIndex < NUM_ALLOCATION_TAGS; tagIndex++)
+	{
+		AllocationStats& stats = s_lastFrameStats[tagIndex];
+		stats.m_numAllocations = s_frameAllocations[tagIndex].exchange(0, std::memory_order_relaxed);
+		stats.m_numBytes = s_frameBytes[tagIndex].exchange(0, std::memory_order_relaxed);
+		stats.m_liveBytes = s_liveBytes[tagIndex].load(std::memory_order_relaxed);
+		stats.m_peakLiveBytes = s_framePeakLiveBytes[tagIndex].exchange(stats.m_liveBytes, std::memory_order_relaxed);
+
+		if (s_budgets[tagIndex] >= 0 && stats.m_numAllocations > s_budgets[tagIndex])
+		{
+			s_numBudgetOverruns[tagIndex]++;
+		}
+	}
+}
+
+
+//
+//accessors
+//
+AllocationStats const& GetLastFrameAllocationStats(AllocationTag tag)
+{
+	return s_lastFrameStats[static_cast<int>(tag)];
+}
+
+
+char const* GetAllocationTagName(AllocationTag tag)
+{
+	switch (tag)
+	{
+	case AllocationTag::UNTAGGED: return "Untagged";
+	case AllocationTag::RENDER:	  return "Render";
+	case AllocationTag::UI_TEXT:  return "UIText";
+	case AllocationTag::COMBAT:	  return "Combat";
+	case AllocationTag::SAVE:	  return "Save";
+	case AllocationTag::LOAD:	  return "Load";
+	default:					  return "Invalid";
+	}
+}
+
+
+//
+//budgets
+//
+void SetAllocationBudget(AllocationTag tag, int maxAllocationsPerFrame)
+{
+	s_budgets[static_cast<int>(tag)] = maxAllocationsPerFrame;
+}
+
+
+int GetAllocationBudget(AllocationTag tag)
+{
+	return s_budgets[static_cast<int>(tag)];
+}
+
+
+int GetNumAllocationBudgetOverruns(AllocationTag tag)
+{
+	return s_numBudgetOverruns[static_cast<int>(tag)];
+}
+
+
+void ResetAllocationBudgetOverruns()
+{
+	for (int tagIndex = 0; tagIndex < NUM_ALLOCATION_TAGS; tagIndex++)
+	{
+		s_numBudgetOverruns[tagIndex] = 0;
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include <cstdint>
+
+
+//-----------------------------------------------------------------------------------------------
+// AllocationTracker.hpp
+//
+// Counts heap allocations per frame, split by what the game was doing when it allocated.
+//	AllocationTracker.cpp replaces the global operator new and delete; each block carries a small
+//	header recording its size and tag, so frees are credited to the scope that allocated them.
+//	Code marks what it's doing with a ScopedAllocationTag; anything outside a tagged scope is UNTAGGED.
+//	The headless simulation farm doesn't link the tracker and keeps the plain allocator, so there the
+//	scoped tags compile to nothing.
+//
+#if !defined(GAME_HEADLESS)
+	#define GAME_TRACK_ALLOCATIONS
+#endif
+
+
+//what the game was doing when it allocated; tags nest, the innermost one wins
+enum class AllocationTag : unsigned char
+{
+	UNTAGGED,
+	RENDER,
+	UI_TEXT,
+	COMBAT,
+	SAVE,
+	LOAD,
+	COUNT
+};
+
+
+//one tag's allocations over one frame
+struct AllocationStats
+{
+	int64_t m_numAllocations = 0;
+	int64_t m_numBytes = 0;		 //bytes allocated this frame
+	int64_t m_liveBytes = 0;		 //bytes allocated under this tag and not yet freed, at the end of the frame
+	int64_t m_peakLiveBytes = 0;	 //highest m_liveBytes reached during the frame
+};
+
+
+#if defined(GAME_TRACK_ALLOCATIONS)
+extern thread_local AllocationTag g_currentAllocationTag;
+#endif
+
+
+//tags every allocation this thread makes until it goes out of scope
+class ScopedAllocationTag
+{
+//public member functions
+public:
+#if defined(GAME_TRACK_ALLOCATIONS)
+	explicit ScopedAllocationTag(AllocationTag tag)
+		: m_previousTag(g_currentAllocationTag)
+	{
+		g_currentAllocationTag = tag;
+	}
+	~ScopedAllocationTag()
+	{
+		g_currentAllocationTag = m_previousTag;
+	}
+#else
+	explicit ScopedAllocationTag(AllocationTag tag) { UNUSED(tag); }
+#endif
+
+	ScopedAllocationTag(ScopedAllocationTag const& copyFrom) = delete;
+	ScopedAllocationTag& operator=(ScopedAllocationTag const& copyFrom) = delete;
+
+//private member variables
+private:
+#if defined(GAME_TRACK_ALLOCATIONS)
+	AllocationTag m_previousTag = AllocationTag::UNTAGGED;
+#endif
+};
+
+
+//only linked where the tracker is (the game and the soak build)
+//frame functions
+void BeginAllocationFrame();	//closes the previous frame's stats and checks them against the budgets
+
+//accessors
+AllocationStats const& GetLastFrameAllocationStats(AllocationTag tag);
+char const* GetAllocationTagName(AllocationTag tag);
+
+//budgets, in allocations per frame; -1 means no budget
+void SetAllocationBudget(AllocationTag tag, int maxAllocationsPerFrame);
+int GetAllocationBudget(AllocationTag tag);
+int GetNumAllocationBudgetOverruns(AllocationTag tag);	//frames in which the tag went over its budget
+void ResetAllocationBudgetOverruns();
@@ -1,6 +1,8 @@
 #include "Game/App.hpp"
 #include "Game/Game.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/AllocationTracker.hpp"
+#include "Game/FrameAllocator.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Audio/AudioSystem.hpp"
@@ -8,6 +10,7 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/StringUtils.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 
 
@@ -18,7 +21,7 @@ InputSystem* g_theInput = nullptr;
 AudioSystem* g_theAudio = nullptr;
 Window*		 g_theWindow = nullptr;
 
-Game* g_theGame = nullptr;
+thread_local Game* g_theGame = nullptr;
 
 
 //public game flow functions
@@ -76,7 +79,9 @@ void App::Startup()
 
 	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "------Debug Controls------");
 	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "Shift: Insta-win");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "T: Toggle speed-up");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "T: Cycle playback speed (1x, 2x, 5x, 10x, uncapped, skip)");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "Command \"playbackrate rate=N\": any playback speed, 0 skips; \"playbackrate uncapped=true\" fast-forwards as fast as the cpu allows");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "Command \"allocations\": last frame's heap allocations by scope; \"allocationoverlay\" keeps them on screen");
 	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "");
 	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "------How to Play------");
 	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, " - Each turn, you will start by drawing five cards from your draw pile into your hand");
@@ -91,6 +96,10 @@ void App::Startup()
 	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "Use the command \"effects\" to learn what each effect does");
 
 	SubscribeEventCallbackFunction("effects", Event_PrintEffects);
+
+	SubscribeEventCallbackFunction("allocations", Event_PrintAllocations);
+	SubscribeEventCallbackFunction("allocationoverlay", Event_ToggleAllocationOverlay);
+	LoadAllocationBudgets();
 }
 
 
@@ -99,6 +108,12 @@ void App::Run()
 	while (!IsQuitting())
 	{
 		RunFrame();
+
+		//nothing is moving or counting down, so sleep until input arrives; idle screens still redraw at a low rate
+		if (m_idleWaitFunction != nullptr && IsIdle())
+		{
+			m_idleWaitFunction(IDLE_FRAME_SECONDS);
+		}
 	}
 }
 
@@ -160,6 +175,23 @@ bool App::HandleQuitRequested()
 }
 
 
+bool App::IsIdle() const
+{
+	if (m_isAllocationOverlayVisible)
+	{
+		return false;
+	}
+
+	return g_theGame->IsIdle();
+}
+
+
+void App::SetIdleWaitFunction(IdleWaitFunction idleWaitFunction)
+{
+	m_idleWaitFunction = idleWaitFunction;
+}
+
+
 //
 //static app utilities
 //
@@ -195,11 +227,48 @@ bool App::Event_PrintEffects(EventArgs& args)
 }
 
 
+bool App::Event_PrintAllocations(EventArgs& args)
+{
+	UNUSED(args);
+
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "------Heap Allocations Last Frame------");
+	for (int tagIndex = 0; tagIndex < static_cast<int>(AllocationTag::COUNT); tagIndex++)
+	{
+		AllocationTag tag = static_cast<AllocationTag>(tagIndex);
+		AllocationStats const& stats = GetLastFrameAllocationStats(tag);
+		int budget = GetAllocationBudget(tag);
+
+		std::string budgetText = (budget >= 0) ? Stringf("budget %i, over in %i frames", budget, GetNumAllocationBudgetOverruns(tag)) : "no budget";
+		Rgba8 lineColor = (budget >= 0 && stats.m_numAllocations > budget) ? DevConsole::COLOR_ERROR : DevConsole::COLOR_INFO_MAJOR;
+		g_theDevConsole->AddLine(lineColor, Stringf("%-8s %6lld allocs %10lld bytes, live %10lld, peak %10lld (%s)", GetAllocationTagName(tag),
+			static_cast<long long>(stats.m_numAllocations), static_cast<long long>(stats.m_numBytes), static_cast<long long>(stats.m_liveBytes),
+			static_cast<long long>(stats.m_peakLiveBytes), budgetText.c_str()));
+	}
+
+	return true;
+}
+
+
+bool App::Event_ToggleAllocationOverlay(EventArgs& args)
+{
+	UNUSED(args);
+
+	if (g_theApp != nullptr)
+	{
+		g_theApp->m_isAllocationOverlayVisible = !g_theApp->m_isAllocationOverlayVisible;
+	}
+
+	return true;
+}
+
+
 //
 //private game flow functions
 //
 void App::BeginFrame()
 {
+	BeginAllocationFrame();
+
 	g_theEventSystem->BeginFrame();
 	g_theDevConsole->BeginFrame();
 	g_theInput->BeginFrame();
@@ -232,6 +301,11 @@ void App::Update()
 		RestartGame();
 	}
 
+	if (m_isAllocationOverlayVisible)
+	{
+		AddAllocationOverlayText();
+	}
+
 	//update the game
 	g_theGame->Update();
 
@@ -240,6 +314,9 @@ void App::Update()
 	{
 		RestartGame();
 	}
+
+	//render prep for next frame starts now, on the worker, and overlaps with Render and the next Update
+	g_theGame->PublishRenderSnapshot();
 }
 
 
@@ -264,6 +341,9 @@ void App::EndFrame()
 	g_theAudio->EndFrame();
 
 	DebugRenderEndFrame();
+
+	//the renderer has copied this frame's vertexes by now, so the scratch memory they came from can be handed out again
+	g_frameAllocator.Reset();
 }
 
 
@@ -284,3 +364,31 @@ void App::RestartGame()
 	g_theGame = new Game();
 	g_theGame->Startup();
 }
+
+
+void App::LoadAllocationBudgets() const
+{
+	//per-frame allocation count budgets, e.g. allocationBudgetRender="0" in GameConfig.xml; unset means no budget
+	for (int tagIndex = 0; tagIndex < static_cast<int>(AllocationTag::COUNT); tagIndex++)
+	{
+		AllocationTag tag = static_cast<AllocationTag>(tagIndex);
+		SetAllocationBudget(tag, g_gameConfigBlackboard.GetValue(Stringf("allocationBudget%s", GetAllocationTagName(tag)), -1));
+	}
+}
+
+
+void App::AddAllocationOverlayText() const
+{
+	//the overlay's own text shows up as untagged allocations in the next frame's numbers
+	for (int tagIndex = 0; tagIndex < static_cast<int>(AllocationTag::COUNT); tagIndex++)
+	{
+		AllocationTag tag = static_cast<AllocationTag>(tagIndex);
+		AllocationStats const& stats = GetLastFrameAllocationStats(tag);
+		int budget = GetAllocationBudget(tag);
+
+		Rgba8 textColor = (budget >= 0 && stats.m_numAllocations > budget) ? Rgba8(255, 0, 0) : Rgba8(255, 255, 0);
+		std::string overlayText = Stringf("%s: %lld allocs, %lld bytes, peak %lld", GetAllocationTagName(tag), static_cast<long long>(stats.m_numAllocations),
+			static_cast<long long>(stats.m_numBytes), static_cast<long long>(stats.m_peakLiveBytes));
+		DebugAddScreenText(overlayText, Vec2(10.0f, SCREEN_CAMERA_SIZE_Y - 60.0f - 15.0f * static_cast<float>(tagIndex)), 12.0f, Vec2(0.0f, 1.0f), 0.0f, textColor, textColor);
+	}
+}
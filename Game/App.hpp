@@ -9,7 +9,15 @@ class Game;
 
 
 //external declarations
-extern Game* g_theGame;
+extern thread_local Game* g_theGame;
+
+
+//constants
+constexpr double IDLE_FRAME_SECONDS = 0.05;	//longest an idle frame waits for input before drawing again anyway
+
+
+//typedefs
+typedef void (*IdleWaitFunction)(double maxWaitSeconds);	//blocks until input arrives or the time runs out
 
 
 class App
@@ -25,10 +33,14 @@ public:
 	//app utilities
 	bool IsQuitting() const { return m_isQuitting; }
 	bool HandleQuitRequested();
+	bool IsIdle() const;
+	void SetIdleWaitFunction(IdleWaitFunction idleWaitFunction);
 
 	//static app utilites
 	static bool Event_Quit(EventArgs& args);
 	static bool Event_PrintEffects(EventArgs& args);
+	static bool Event_PrintAllocations(EventArgs& args);
+	static bool Event_ToggleAllocationOverlay(EventArgs& args);
 
 //private member variables
 private:
@@ -40,9 +52,13 @@ private:
 
 	//app utilities
 	void RestartGame();
+	void LoadAllocationBudgets() const;
+	void AddAllocationOverlayText() const;
 
 //private member variables
 private:
 	bool m_isQuitting = false;
+	bool m_isAllocationOverlayVisible = false;
+	IdleWaitFunction m_idleWaitFunction = nullptr;	//set by the platform's main; without one every frame runs back to back
 	Camera m_devConsoleCamera;
 };
@@ -7,11 +7,13 @@
 #include "Game/Player.hpp"
 #include "Game/Enemy.hpp"
 #include "Game/Encounter.hpp"
+#include "Game/RunTelemetry.hpp"
+#include "Game/AllocationTracker.hpp"
+#include "Game/FrameAllocator.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
-#include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Audio/AudioSystem.hpp"
 
@@ -26,196 +28,27 @@ Card::Card(CardDefinition const* definition, Player* player)
 }
 
 
+#if !defined(GAME_HEADLESS)
 //
 //public game flow functions
 //
-void Card::Update(int cardPosition, bool& wasCardPlayed, bool isReward)
+void Card::Render(AABB2 const& cardBounds) const
 {
-	if (g_theInput->WasKeyJustPressed(KEYCODE_LMB))
-	{
-		Vec2 mousePosition = g_theInput->GetCursorNormalizedPosition();
-		Vec2 gameMousePosition = Vec2(mousePosition.x * SCREEN_CAMERA_SIZE_X, mousePosition.y * SCREEN_CAMERA_SIZE_Y);
-		
-		//go ahead and return if click was within bounds of a button
-		if (IsPointInsideAABB2D(gameMousePosition, g_theGame->m_endTurnButton->m_bounds))
-		{
-			return;
-		}
-		
-		if (cardPosition > MAX_HAND_SIZE - 1)
-		{
-			//don't bother if the card somehow has a higher position than what it should have
-			return;
-		}
-
-		//I know this is a dumb way of doing this but I just want something functional for now
-		AABB2 cardBounds = AABB2();
-		if (cardPosition == 0)
-		{
-			if (isReward)
-			{
-				cardBounds = AABB2(SCREEN_CAMERA_CENTER_X - 360.0f, SCREEN_CAMERA_CENTER_Y - 120.0f, SCREEN_CAMERA_CENTER_X - 200.0f, SCREEN_CAMERA_CENTER_Y + 120.0f);
-			}
-			else
-			{
-				cardBounds = AABB2(SCREEN_CAMERA_CENTER_X - 440.0f, 10.0f, SCREEN_CAMERA_CENTER_X - 280.0f, 250.0f);
-			}
-		}
-		else if (cardPosition == 1)
-		{
-			if (isReward)
-			{
-				cardBounds = AABB2(SCREEN_CAMERA_CENTER_X - 80.0f, SCREEN_CAMERA_CENTER_Y - 120.0f, SCREEN_CAMERA_CENTER_X + 80.0f, SCREEN_CAMERA_CENTER_Y + 120.0f);
-			}
-			else
-			{
-				cardBounds = AABB2(SCREEN_CAMERA_CENTER_X - 260.0f, 10.0f, SCREEN_CAMERA_CENTER_X - 100.0f, 250.0f);
-			}
-		}
-		else if (cardPosition == 2)
-		{
-			if (isReward)
-			{
-				cardBounds = AABB2(SCREEN_CAMERA_CENTER_X + 200.0f, SCREEN_CAMERA_CENTER_Y - 120.0f, SCREEN_CAMERA_CENTER_X + 360.0f, SCREEN_CAMERA_CENTER_Y + 120.0f);
-			}
-			else
-			{
-				cardBounds = AABB2(SCREEN_CAMERA_CENTER_X - 80.0f, 10.0f, SCREEN_CAMERA_CENTER_X + 80.0f, 250.0f);
-			}
-		}
-		else if (cardPosition == 3)
-		{
-			cardBounds = AABB2(SCREEN_CAMERA_CENTER_X + 100.0f, 10.0f, SCREEN_CAMERA_CENTER_X + 260.0f, 250.0f);
-		}
-		else if (cardPosition == 4)
-		{
-			cardBounds = AABB2(SCREEN_CAMERA_CENTER_X + 280.0f, 10.0f, SCREEN_CAMERA_CENTER_X + 440.0f, 250.0f);
-		}
-
-		//different input logic for card rewards
-		if (isReward)
-		{
-			if (IsPointInsideAABB2D(gameMousePosition, cardBounds))
-			{
-				wasCardPlayed = true;	//use wasCardPlayed to pass whether card reward was chosen in this instance
-				return;
-			}
-		}
-
-		AABB2 playingFieldBounds = AABB2(0.0f, 255.0f, SCREEN_CAMERA_SIZE_X, SCREEN_CAMERA_SIZE_Y);
-
-		if (IsPointInsideAABB2D(gameMousePosition, cardBounds))
-		{
-			if (this != m_player->m_selectedCard)
-			{
-				m_player->m_selectedCard = this;
-				g_theAudio->StartSound(g_cardSound);
-			}
-			else
-			{
-				m_player->m_selectedCard = nullptr;
-			}
-		}
-		else if(IsPointInsideAABB2D(gameMousePosition, playingFieldBounds))
-		{
-			if (this == m_player->m_selectedCard)
-			{
-				m_player->m_selectedCard = nullptr;
+	FrameVerts cardVerts;
+	cardVerts.reserve(6);
+	AddVertsForAABB2(cardVerts, cardBounds, Rgba8(), m_definition->m_spriteUVs);
 
-				if (!m_definition->m_isPlayable)
-				{
-					return;
-				}
-				
-				if (m_definition->m_targetMode == TargetMode::ONE)
-				{
-					//for now, just temporarily get the first enemy
-					Encounter* encounter = g_theGame->m_map->m_allEncounters[g_theGame->m_map->m_currentEncounterNumber];
-					Enemy* enemyTarget = nullptr;
-					for (int enemyIndex = 0; enemyIndex < encounter->m_currentEnemies.size(); enemyIndex++)
-					{
-						Enemy* enemy = encounter->m_currentEnemies[enemyIndex];
-
-						if (enemy != nullptr && enemy->m_currentHealth > 0 && IsPointInsideAABB2D(gameMousePosition, enemy->m_renderBounds))
-						{
-							enemyTarget = enemy;
-						}
-					}
+	g_theRenderer->BindTexture(m_definition->m_sprite);
+	g_theRenderer->BindShader(nullptr);
+	DrawFrameVerts(cardVerts);
 
-					if (enemyTarget != nullptr)
-					{
-						wasCardPlayed = m_player->PlayCard(this, enemyTarget);
-					}
-				}
-				else
-				{
-					wasCardPlayed = m_player->PlayCard(this, nullptr);
-				}
-			}
-		}
-	}
+	RenderDetails(cardBounds);
 }
 
 
-void Card::Render(int cardPosition, bool isReward) const
+void Card::RenderDetails(AABB2 const& cardBounds) const
 {
-	if (cardPosition > MAX_HAND_SIZE - 1)
-	{
-		//don't bother if the card somehow has a higher position than what it should have
-		return;
-	}
-
-	//I know this is a dumb way of doing this but I just want something functional for now
-	AABB2 cardBounds = AABB2();
-	if (cardPosition == 0)
-	{
-		if (isReward)
-		{
-			cardBounds = AABB2(SCREEN_CAMERA_CENTER_X - 360.0f, SCREEN_CAMERA_CENTER_Y - 120.0f, SCREEN_CAMERA_CENTER_X - 200.0f, SCREEN_CAMERA_CENTER_Y + 120.0f);
-		}
-		else
-		{
-			cardBounds = AABB2(SCREEN_CAMERA_CENTER_X - 440.0f, 10.0f, SCREEN_CAMERA_CENTER_X - 280.0f, 250.0f);
-		}
-	}
-	else if (cardPosition == 1)
-	{
-		if (isReward)
-		{
-			cardBounds = AABB2(SCREEN_CAMERA_CENTER_X - 80.0f, SCREEN_CAMERA_CENTER_Y - 120.0f, SCREEN_CAMERA_CENTER_X + 80.0f, SCREEN_CAMERA_CENTER_Y + 120.0f);
-		}
-		else
-		{
-			cardBounds = AABB2(SCREEN_CAMERA_CENTER_X - 260.0f, 10.0f, SCREEN_CAMERA_CENTER_X - 100.0f, 250.0f);
-		}
-	}
-	else if (cardPosition == 2)
-	{
-		if (isReward)
-		{
-			cardBounds = AABB2(SCREEN_CAMERA_CENTER_X + 200.0f, SCREEN_CAMERA_CENTER_Y - 120.0f, SCREEN_CAMERA_CENTER_X + 360.0f, SCREEN_CAMERA_CENTER_Y + 120.0f);
-		}
-		else
-		{
-			cardBounds = AABB2(SCREEN_CAMERA_CENTER_X -80.0f, 10.0f, SCREEN_CAMERA_CENTER_X + 80.0f, 250.0f);
-		}
-	}
-	else if (cardPosition == 3)
-	{
-		cardBounds = AABB2(SCREEN_CAMERA_CENTER_X + 100.0f, 10.0f, SCREEN_CAMERA_CENTER_X + 260.0f, 250.0f);
-	}
-	else if (cardPosition == 4)
-	{
-		cardBounds = AABB2(SCREEN_CAMERA_CENTER_X + 280.0f, 10.0f, SCREEN_CAMERA_CENTER_X + 440.0f, 250.0f);
-	}
-
-	std::vector<Vertex_PCU> cardVerts;
-
-	AddVertsForAABB2(cardVerts, cardBounds);
-
-	g_theRenderer->BindTexture(m_definition->m_sprite);
-	g_theRenderer->BindShader(nullptr);
-	g_theRenderer->DrawVertexArray(cardVerts);
+	ScopedAllocationTag allocationTag(AllocationTag::UI_TEXT);
 
 	//print cost of card
 	if (m_definition->m_isPlayable)
@@ -224,140 +57,135 @@ void Card::Render(int cardPosition, bool isReward) const
 		DebugAddScreenText(energyCost, Vec2(cardBounds.m_mins.x + 10.5f, cardBounds.m_maxs.y - 17.5f), 15.0f, Vec2(0.0f, 1.0f), 0.0f, Rgba8(0, 0, 0), Rgba8(0, 0, 0));
 	}
 
-	//print card name and description
-	std::vector<Vertex_PCU> textVerts;
-	AABB2 nameBox = AABB2(cardBounds.m_mins.x + 35.0f, cardBounds.m_maxs.y - 40.0f, cardBounds.m_maxs.x - 30.0f, cardBounds.m_maxs.y - 25.0f);
-	g_font->AddVertsForTextInBox2D(textVerts, nameBox, 15.0f, m_definition->m_name, Rgba8(0, 0, 0), 0.8f, Vec2(0.5f, 1.0f));
-
-	AABB2 descBox = AABB2(cardBounds.m_mins.x + 30.0f, cardBounds.m_mins.y + 20.0f, cardBounds.m_maxs.x - 30.0f, (cardBounds.m_mins.y + cardBounds.m_maxs.y) * 0.5f);
-	std::string const description = m_definition->m_description;
-	g_font->AddVertsForTextInBox2D(textVerts, descBox, 10.0f, description, Rgba8(), 0.7f, Vec2(0.5f, 0.5f));
-
-	g_theRenderer->BindTexture(&g_font->GetTexture());
-	g_theRenderer->DrawVertexArray(textVerts);
+	//print card name and description; laying the text out is the expensive part, so it's only redone when the card moves
+	bool hasMoved = cardBounds.m_mins.x != m_textLayerBounds.m_mins.x || cardBounds.m_mins.y != m_textLayerBounds.m_mins.y || cardBounds.m_maxs.x != m_textLayerBounds.m_maxs.x || cardBounds.m_maxs.y != m_textLayerBounds.m_maxs.y;
+	if (m_textLayer.IsDirty() || hasMoved || m_textLayerDefinition != m_definition || m_textLayerRevision != m_definition->m_revision)
+	{
+		RebuildTextLayer(cardBounds);
+	}
+	m_textLayer.Render();
 
 	//if card is selected card, draw overlay on top of it
 	if (m_player->m_selectedCard == this)
 	{
-		std::vector<Vertex_PCU> overlayVerts;
+		FrameVerts overlayVerts;
+		overlayVerts.reserve(6);
 		AddVertsForAABB2(overlayVerts, cardBounds, Rgba8(255, 255, 255, 75));
 
 		g_theRenderer->BindTexture(nullptr);
-		g_theRenderer->DrawVertexArray(overlayVerts);
+		DrawFrameVerts(overlayVerts);
 	}
 }
 
 
+//
+//private game flow functions
+//
+void Card::RebuildTextLayer(AABB2 const& cardBounds) const
+{
+	m_textLayerBounds = cardBounds;
+	m_textLayerDefinition = m_definition;
+	m_textLayerRevision = m_definition->m_revision;
+	std::vector<Vertex_PCU>& textVerts = m_textLayer.BeginRebuild(&g_font->GetTexture());
+
+	AABB2 nameBox = AABB2(cardBounds.m_mins.x + 35.0f, cardBounds.m_maxs.y - 40.0f, cardBounds.m_maxs.x - 30.0f, cardBounds.m_maxs.y - 25.0f);
+	g_font->AddVertsForTextInBox2D(textVerts, nameBox, 15.0f, m_definition->m_name, Rgba8(0, 0, 0), 0.8f, Vec2(0.5f, 1.0f));
+
+	AABB2 descBox = AABB2(cardBounds.m_mins.x + 30.0f, cardBounds.m_mins.y + 20.0f, cardBounds.m_maxs.x - 30.0f, (cardBounds.m_mins.y + cardBounds.m_maxs.y) * 0.5f);
+	g_font->AddVertsForTextInBox2D(textVerts, descBox, 10.0f, m_definition->m_description, Rgba8(), 0.7f, Vec2(0.5f, 0.5f));
+}
+#endif
+
+
 //
 //public card actions
 //
 void Card::Play(Enemy* enemyTarget, Encounter* currentEncounter) const
 {
-	//deal damage
-	if (m_definition->m_targetMode == TargetMode::ONE)
+	std::vector<CardOp> const& ops = m_definition->m_ops;
+
+	for (int opIndex = 0; opIndex < ops.size(); opIndex++)
 	{
-		//calculate final damage amount
-		int finalDamage = m_definition->m_damage;
-		for (int effectIndex = 0; effectIndex < m_player->m_effects.size(); effectIndex++)
-		{
-			Effect const& effect = m_player->m_effects[effectIndex];
+		CardOp const& op = ops[opIndex];
 
-			if (effect.m_definition->m_modDealtDamage)
-			{
-				if (effect.m_definition->m_usePercentage)
-				{
-					finalDamage = static_cast<int>(static_cast<float>(finalDamage) * effect.m_definition->m_percentModifier);
-				}
-				else
-				{
-					finalDamage += effect.m_stack;
-				}
-			}
-		}
-		for (int effectIndex = 0; effectIndex < enemyTarget->m_effects.size(); effectIndex++)
+		switch (op.m_opCode)
 		{
-			Effect const& effect = enemyTarget->m_effects[effectIndex];
-
-			if (effect.m_definition->m_modReceivedDamage)
+		case CardOpCode::DEAL:
+		case CardOpCode::APPLY:
+		{
+			if (op.m_targetMode == TargetMode::ONE)
 			{
-				if (effect.m_definition->m_usePercentage)
+				if (op.m_opCode == CardOpCode::DEAL)
 				{
-					finalDamage = static_cast<int>(static_cast<float>(finalDamage) * effect.m_definition->m_percentModifier);
+					DealDamage(op, enemyTarget);
 				}
 				else
 				{
-					finalDamage += effect.m_stack;
+					enemyTarget->ReceiveEffect(op.m_effect, op.m_count);
 				}
 			}
-		}
-
-		for (int hitNum = 0; hitNum < m_definition->m_numHits; hitNum++)
-		{
-			enemyTarget->TakeDamage(finalDamage);
-		}
-
-		//inflict effect
-		if (m_definition->m_inflictEffect != nullptr)
-		{
-			enemyTarget->ReceiveEffect(m_definition->m_inflictEffect, m_definition->m_inflictEffectStack);
-		}
-	}
-	else if (m_definition->m_targetMode == TargetMode::ALL)
-	{
-		for (int enemyIndex = 0; enemyIndex < currentEncounter->m_currentEnemies.size(); enemyIndex++)
-		{
-			Enemy* enemy = currentEncounter->m_currentEnemies[enemyIndex];
-			if (enemy != nullptr && enemy->m_currentHealth > 0)
+			else if (op.m_targetMode == TargetMode::ALL)
 			{
-				//calculate final damage amount
-				int finalDamage = m_definition->m_damage;
-				for (int effectIndex = 0; effectIndex < m_player->m_effects.size(); effectIndex++)
+				for (int enemyIndex = 0; enemyIndex < currentEncounter->m_currentEnemies.size(); enemyIndex++)
 				{
-					Effect const& effect = m_player->m_effects[effectIndex];
+					Enemy* enemy = currentEncounter->m_currentEnemies[enemyIndex];
+					if (enemy == nullptr || enemy->m_currentHealth == 0)
+					{
+						continue;
+					}
 
-					if (effect.m_definition->m_modDealtDamage)
+					if (op.m_opCode == CardOpCode::DEAL)
+					{
+						DealDamage(op, enemy);
+					}
+					else
 					{
-						if (effect.m_definition->m_usePercentage)
-						{
-							finalDamage = static_cast<int>(static_cast<float>(finalDamage) * effect.m_definition->m_percentModifier);
-						}
-						else
-						{
-							finalDamage += effect.m_stack;
-						}
+						enemy->ReceiveEffect(op.m_effect, op.m_count);
 					}
 				}
-				for (int effectIndex = 0; effectIndex < enemy->m_effects.size(); effectIndex++)
+			}
+			else if (op.m_targetMode == TargetMode::SELF)
+			{
+				if (op.m_opCode == CardOpCode::DEAL)
 				{
-					Effect const& effect = enemy->m_effects[effectIndex];
-
-					if (effect.m_definition->m_modReceivedDamage)
+					for (int hitNum = 0; hitNum < op.m_count; hitNum++)
 					{
-						if (effect.m_definition->m_usePercentage)
-						{
-							finalDamage = static_cast<int>(static_cast<float>(finalDamage) * effect.m_definition->m_percentModifier);
-						}
-						else
-						{
-							finalDamage += effect.m_stack;
-						}
+						m_player->TakeDamage(op.m_amount);
 					}
 				}
-
-				for (int hitNum = 0; hitNum < m_definition->m_numHits; hitNum++)
+				else
 				{
-					enemy->TakeDamage(finalDamage);
+					m_player->ReceiveEffect(op.m_effect, op.m_count);
 				}
 			}
-
-			//inflict effect
-			if (m_definition->m_inflictEffect != nullptr)
+			else
+			{
+				//definitions refuse these on load, so only a broken op table gets here; hitting the player instead would hide it
+				ERROR_RECOVERABLE(Stringf("Card \"%s\" has a damage or effect op with no target, skipping it", m_definition->m_name.c_str()));
+			}
+			break;
+		}
+		case CardOpCode::BLOCK:
+		{
+			int blockAmount = m_player->ModifyAmount(EffectTrigger::BLOCK_GAINED, op.m_amount);
+			m_player->GainBlock(blockAmount);
+			g_runTelemetry.RecordPlayerBlock(blockAmount);
+			break;
+		}
+		case CardOpCode::RESTORE_HP: m_player->RestoreHealth(op.m_amount); break;
+		case CardOpCode::ENERGY:	 m_player->GainEnergy(op.m_amount); break;
+		case CardOpCode::DRAW:
+		{
+			for (int drawNum = 0; drawNum < op.m_count; drawNum++)
 			{
-				enemy->ReceiveEffect(m_definition->m_inflictEffect, m_definition->m_inflictEffectStack);
+				m_player->DrawCard();
 			}
+			break;
+		}
 		}
 	}
 
+#if !defined(GAME_HEADLESS)
 	switch (m_definition->m_attackType)
 	{
 	case AttackType::SLICE:		   g_theAudio->StartSound(g_attackSliceSound); break;
@@ -367,47 +195,25 @@ void Card::Play(Enemy* enemyTarget, Encounter* currentEncounter) const
 	case AttackType::FIRE:		   g_theAudio->StartSound(g_attackFireSound); break;
 	case AttackType::MAGIC:		   g_theAudio->StartSound(g_attackMagicSound); break;
 	}
+#endif
+}
 
-	//calculate final block amount
-	int finalBlock = m_definition->m_block;
-	if (finalBlock != 0)
-	{
-		for (int effectIndex = 0; effectIndex < m_player->m_effects.size(); effectIndex++)
-		{
-			Effect const& effect = m_player->m_effects[effectIndex];
-
-			if (effect.m_definition->m_modBlock)
-			{
-				if (effect.m_definition->m_usePercentage)
-				{
-					finalBlock = static_cast<int>(static_cast<float>(finalBlock) * effect.m_definition->m_percentModifier);
-				}
-				else
-				{
-					finalBlock += effect.m_stack;
-				}
-			}
-		}
-	}
-
-	//gain block
-	m_player->GainBlock(finalBlock);
 
-	//restore health
-	m_player->RestoreHealth(m_definition->m_restoreHP);
+//
+//private op helpers
+//
+void Card::DealDamage(CardOp const& op, Enemy* enemy) const
+{
+	//modifiers are resolved once per target, then every hit lands for the same amount
+	int finalDamage = m_player->ModifyAmount(EffectTrigger::DAMAGE_DEALT, op.m_amount);
+	finalDamage = enemy->ModifyAmount(EffectTrigger::DAMAGE_RECEIVED, finalDamage);
 
-	//draw card
-	for (int drawNum = 0; drawNum < m_definition->m_cardsDrawn; drawNum++)
+	int startingHealth = enemy->m_currentHealth;
+	for (int hitNum = 0; hitNum < op.m_count; hitNum++)
 	{
-		m_player->DrawCard();
+		enemy->TakeDamage(finalDamage);
 	}
 
-	//gain energy
-	m_player->GainEnergy(m_definition->m_energyGain);
-
-	//gain effect
-	if (m_definition->m_gainEffect != nullptr)
-	{
-		m_player->ReceiveEffect(m_definition->m_gainEffect, m_definition->m_gainEffectStack);
-	}
+	//what actually came off the enemy's health, after block and overkill
+	g_runTelemetry.RecordCardDamage(m_definition->m_handle.GetIndex(), startingHealth - enemy->m_currentHealth);
 }
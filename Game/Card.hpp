@@ -1,4 +1,6 @@
 #pragma once
+#include "Game/SceneLayer.hpp"
+#include "Engine/Math/AABB2.hpp"
 
 
 //forward declarations
@@ -6,6 +8,7 @@ class CardDefinition;
 class Enemy;
 class Encounter;
 class Player;
+struct CardOp;
 
 
 class Card
@@ -17,14 +20,30 @@ public:
 	explicit Card(CardDefinition const* definition, Player* player);
 
 	//game flow functions
-	void Update(int cardPosition, bool& wasCardPlayed, bool isReward = false);
-	void Render(int cardPosition, bool isReward = false) const;
+	void Render(AABB2 const& cardBounds) const;
+	void RenderDetails(AABB2 const& cardBounds) const;	//everything drawn over the card art
 
 	//card actions
 	void Play(Enemy* enemyTarget, Encounter* currentEncounter) const;
 
+//private member functions
+private:
+	//game flow functions
+	void RebuildTextLayer(AABB2 const& cardBounds) const;
+
+	//op helpers
+	void DealDamage(CardOp const& op, Enemy* enemy) const;
+
 //public member variables
 public:
 	CardDefinition const* m_definition = nullptr;
 	Player* m_player = nullptr;
+
+//private member variables
+private:
+	//name and description text, kept until the card is drawn somewhere else or its definition is reloaded
+	mutable SceneLayer			  m_textLayer;
+	mutable AABB2				  m_textLayerBounds;
+	mutable CardDefinition const* m_textLayerDefinition = nullptr;
+	mutable int					  m_textLayerRevision = -1;
 };
@@ -1,4 +1,5 @@
 #include "Game/CardDefinition.hpp"
+#include "Game/SpriteAtlas.hpp"
 #include "Game/EffectDefinition.hpp"
 #include "Game/GameCommon.hpp"
 #include "Engine/Renderer/Texture.hpp"
@@ -8,6 +9,7 @@
 
 //static variable declaration
 std::vector<CardDefinition> CardDefinition::s_cardDefs;
+uint32_t CardDefinition::s_registryGeneration = 0;
 
 
 //
@@ -19,8 +21,12 @@ CardDefinition::CardDefinition(XmlElement const& element)
 	m_description = ParseXmlAttribute(element, "description", m_description);
 	ReplacePartOfString(m_description, "\\n", "\n");	//this has to be done because tinyxml reads in \n incorrectly
 	
+#if !defined(GAME_HEADLESS)
 	std::string textureFilePath = ParseXmlAttribute(element, "sprite", "invalid file path");
-	m_sprite = g_theRenderer->CreateOrGetTextureFromFile(textureFilePath.c_str());
+	AtlasSprite sprite = g_spriteAtlas.GetSprite(textureFilePath);
+	m_sprite = sprite.m_texture;
+	m_spriteUVs = sprite.m_uvs;
+#endif
 
 	std::string typeString = ParseXmlAttribute(element, "type", "Invalid");
 	if (typeString == "Attack")
@@ -67,22 +73,8 @@ CardDefinition::CardDefinition(XmlElement const& element)
 	}
 	
 	std::string targetModeString = ParseXmlAttribute(element, "targetMode", "None");
-	if (targetModeString == "One")
-	{
-		m_targetMode = TargetMode::ONE;
-	}
-	else if (targetModeString == "All")
-	{
-		m_targetMode = TargetMode::ALL;
-	}
-	else if (targetModeString == "Self")
-	{
-		m_targetMode = TargetMode::SELF;
-	}
-	else
-	{
-		m_targetMode = TargetMode::NONE;
-	}
+	m_targetMode = GetTargetModeFromName(targetModeString);
+	GUARANTEE_OR_DIE(m_targetMode != TargetMode::INVALID, Stringf("Card \"%s\" has unknown targetMode \"%s\"!", m_name.c_str(), targetModeString.c_str()));
 
 	std::string attackTypeString = ParseXmlAttribute(element, "attackType", "None");
 	if (attackTypeString == "Slice")
@@ -132,6 +124,17 @@ CardDefinition::CardDefinition(XmlElement const& element)
 
 	m_exhaust = ParseXmlAttribute(element, "exhaust", m_exhaust);
 	m_isPlayable = ParseXmlAttribute(element, "isPlayable", m_isPlayable);
+
+	//cards with an action list do exactly what it says, in order; everything else compiles from the flat parameters
+	XmlElement const* actionsElement = element.FirstChildElement("Actions");
+	if (actionsElement != nullptr)
+	{
+		CompileOpsFromActions(*actionsElement);
+	}
+	else
+	{
+		CompileOpsFromParameters();
+	}
 }
 
 
@@ -148,16 +151,18 @@ void CardDefinition::InitializeCardDefs()
 	XmlElement* rootElement = cardDefsXml.RootElement();
 	GUARANTEE_OR_DIE(rootElement != nullptr, "Failed to read card definitions root element!");
 
+	s_registryGeneration++;
+
 	XmlElement* cardDefElement = rootElement->FirstChildElement();
-	uint8_t currentCardID = 0;
+	uint32_t currentCardIndex = 0;
 	while (cardDefElement != nullptr)
 	{
 		std::string elementName = cardDefElement->Name();
 		GUARANTEE_OR_DIE(elementName == "CardDefinition", "Child element names in card definitions xml file must be <CardDefinition>!");
 		CardDefinition newCardDef = CardDefinition(*cardDefElement);
-		newCardDef.m_id = currentCardID;
+		newCardDef.m_handle = CardDefHandle(currentCardIndex, s_registryGeneration);
 		s_cardDefs.emplace_back(newCardDef);
-		currentCardID++;
+		currentCardIndex++;
 		cardDefElement = cardDefElement->NextSiblingElement();
 	}
 }
@@ -176,3 +181,204 @@ CardDefinition const* CardDefinition::GetCardDefinition(std::string name)
 	//return null if it wasn't found
 	return nullptr;
 }
+
+
+CardDefinition const* CardDefinition::GetCardDefinition(CardDefHandle handle)
+{
+	if (!handle.IsValid() || handle.GetIndex() >= s_cardDefs.size())
+	{
+		return nullptr;
+	}
+
+	handle.CheckGeneration(s_registryGeneration);
+	return &s_cardDefs[handle.GetIndex()];
+}
+
+
+CardDefHandle CardDefinition::GetCardDefHandle(uint32_t index)
+{
+	if (index >= s_cardDefs.size())
+	{
+		return CardDefHandle();
+	}
+
+	return CardDefHandle(index, s_registryGeneration);
+}
+
+
+TargetMode CardDefinition::GetTargetModeFromName(std::string const& targetModeName)
+{
+	if (targetModeName == "One")
+	{
+		return TargetMode::ONE;
+	}
+	else if (targetModeName == "All")
+	{
+		return TargetMode::ALL;
+	}
+	else if (targetModeName == "Self")
+	{
+		return TargetMode::SELF;
+	}
+	else if (targetModeName == "None")
+	{
+		return TargetMode::NONE;
+	}
+	
+	return TargetMode::INVALID;
+}
+
+
+bool CardDefinition::IsValidXml(XmlElement const& element, std::string& out_problem)
+{
+	std::string name = ParseXmlAttribute(element, "name", "");
+	std::string cardTargetModeName = ParseXmlAttribute(element, "targetMode", "None");
+	TargetMode cardTargetMode = GetTargetModeFromName(cardTargetModeName);
+	if (cardTargetMode == TargetMode::INVALID)
+	{
+		out_problem = Stringf("Card \"%s\" has unknown targetMode \"%s\"", name.c_str(), cardTargetModeName.c_str());
+		return false;
+	}
+
+	XmlElement const* actionsElement = element.FirstChildElement("Actions");
+	if (actionsElement == nullptr)
+	{
+		return true;
+	}
+
+	XmlElement const* actionElement = actionsElement->FirstChildElement();
+	while (actionElement != nullptr)
+	{
+		std::string actionName = actionElement->Name();
+		std::string targetModeName = ParseXmlAttribute(*actionElement, "target", "Self");
+		TargetMode targetMode = GetTargetModeFromName(targetModeName);
+		if (targetMode == TargetMode::NONE || targetMode == TargetMode::INVALID)
+		{
+			out_problem = Stringf("Card \"%s\" has a <%s> action with unknown target \"%s\"", name.c_str(), actionName.c_str(), targetModeName.c_str());
+			return false;
+		}
+		if (targetMode == TargetMode::ONE && cardTargetMode != TargetMode::ONE)
+		{
+			out_problem = Stringf("Card \"%s\" has a single target action but its targetMode isn't One", name.c_str());
+			return false;
+		}
+
+		if (actionName == "Apply")
+		{
+			std::string effectName = ParseXmlAttribute(*actionElement, "effect", "invalid effect");
+			if (EffectDefinition::GetEffectDefinition(effectName) == nullptr)
+			{
+				out_problem = Stringf("Card \"%s\" applies unknown effect \"%s\"", name.c_str(), effectName.c_str());
+				return false;
+			}
+		}
+
+		actionElement = actionElement->NextSiblingElement();
+	}
+
+	return true;
+}
+
+
+//
+//private op compilation functions
+//
+void CardDefinition::CompileOpsFromParameters()
+{
+	bool targetsEnemies = m_targetMode == TargetMode::ONE || m_targetMode == TargetMode::ALL;
+
+	//same order Card::Play has always resolved the flat parameters in
+	//a targeted card hits even for 0 base damage, since damage modifiers (strength) still apply to it
+	if (targetsEnemies && m_numHits > 0)
+	{
+		AddOp(CardOpCode::DEAL, m_damage, m_numHits, m_targetMode);
+	}
+	if (targetsEnemies && m_inflictEffect != nullptr)
+	{
+		AddOp(CardOpCode::APPLY, 0, m_inflictEffectStack, m_targetMode, m_inflictEffect);
+	}
+	if (m_block != 0)
+	{
+		AddOp(CardOpCode::BLOCK, m_block, 0, TargetMode::SELF);
+	}
+	if (m_restoreHP != 0)
+	{
+		AddOp(CardOpCode::RESTORE_HP, m_restoreHP, 0, TargetMode::SELF);
+	}
+	if (m_cardsDrawn > 0)
+	{
+		AddOp(CardOpCode::DRAW, 0, m_cardsDrawn, TargetMode::SELF);
+	}
+	if (m_energyGain != 0)
+	{
+		AddOp(CardOpCode::ENERGY, m_energyGain, 0, TargetMode::SELF);
+	}
+	if (m_gainEffect != nullptr)
+	{
+		AddOp(CardOpCode::APPLY, 0, m_gainEffectStack, TargetMode::SELF, m_gainEffect);
+	}
+}
+
+
+void CardDefinition::CompileOpsFromActions(XmlElement const& actionsElement)
+{
+	XmlElement const* actionElement = actionsElement.FirstChildElement();
+	while (actionElement != nullptr)
+	{
+		std::string actionName = actionElement->Name();
+		std::string targetModeName = ParseXmlAttribute(*actionElement, "target", "Self");
+		TargetMode targetMode = GetTargetModeFromName(targetModeName);
+
+		//a typo'd target must not quietly fall through to the player
+		GUARANTEE_OR_DIE(targetMode != TargetMode::NONE && targetMode != TargetMode::INVALID, Stringf("Card \"%s\" has a <%s> action with unknown target \"%s\"!", m_name.c_str(), actionName.c_str(), targetModeName.c_str()));
+
+		//the player only picks a target for cards that say they need one
+		GUARANTEE_OR_DIE(targetMode != TargetMode::ONE || m_targetMode == TargetMode::ONE, Stringf("Card \"%s\" has a single target action but its targetMode isn't One!", m_name.c_str()));
+
+		if (actionName == "Deal")
+		{
+			AddOp(CardOpCode::DEAL, ParseXmlAttribute(*actionElement, "damage", 0), ParseXmlAttribute(*actionElement, "numHits", 1), targetMode);
+		}
+		else if (actionName == "Apply")
+		{
+			std::string effectName = ParseXmlAttribute(*actionElement, "effect", "invalid effect");
+			EffectDefinition const* effect = EffectDefinition::GetEffectDefinition(effectName);
+			GUARANTEE_OR_DIE(effect != nullptr, Stringf("Card \"%s\" applies unknown effect \"%s\"!", m_name.c_str(), effectName.c_str()));
+			AddOp(CardOpCode::APPLY, 0, ParseXmlAttribute(*actionElement, "stack", 1), targetMode, effect);
+		}
+		else if (actionName == "Block")
+		{
+			AddOp(CardOpCode::BLOCK, ParseXmlAttribute(*actionElement, "block", 0), 0, TargetMode::SELF);
+		}
+		else if (actionName == "RestoreHP")
+		{
+			AddOp(CardOpCode::RESTORE_HP, ParseXmlAttribute(*actionElement, "restoreHP", 0), 0, TargetMode::SELF);
+		}
+		else if (actionName == "Draw")
+		{
+			AddOp(CardOpCode::DRAW, 0, ParseXmlAttribute(*actionElement, "cardsDrawn", 1), TargetMode::SELF);
+		}
+		else if (actionName == "Energy")
+		{
+			AddOp(CardOpCode::ENERGY, ParseXmlAttribute(*actionElement, "energyGain", 0), 0, TargetMode::SELF);
+		}
+		else
+		{
+			ERROR_RECOVERABLE(Stringf("Card \"%s\" has unknown action <%s>, skipping it", m_name.c_str(), actionName.c_str()));
+		}
+
+		actionElement = actionElement->NextSiblingElement();
+	}
+}
+
+
+void CardDefinition::AddOp(CardOpCode opCode, int amount, int count, TargetMode targetMode, EffectDefinition const* effect)
+{
+	CardOp op;
+	op.m_opCode = opCode;
+	op.m_amount = amount;
+	op.m_count = count;
+	op.m_targetMode = targetMode;
+	op.m_effect = effect;
+	m_ops.emplace_back(op);
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "Game/DefinitionHandle.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Renderer/Texture.hpp"
 
@@ -6,6 +7,11 @@
 //forward declarations
 class Texture;
 class EffectDefinition;
+class CardDefinition;
+
+
+//typedefs
+typedef DefinitionHandle<CardDefinition> CardDefHandle;
 
 
 //constants
@@ -28,7 +34,8 @@ enum class TargetMode
 	ONE,
 	ALL,
 	SELF,
-	NONE
+	NONE,
+	INVALID		//a name that isn't one of the above; never compiled into an op
 };
 
 enum class CardRarity
@@ -51,6 +58,27 @@ enum class AttackType
 	NONE
 };
 
+enum class CardOpCode : unsigned char
+{
+	DEAL,		//m_amount damage m_count times to m_targetMode
+	APPLY,		//m_count stacks of m_effect to m_targetMode
+	BLOCK,		//m_amount block to the player
+	RESTORE_HP,	//m_amount health to the player
+	DRAW,		//m_count cards
+	ENERGY,		//m_amount energy to the player
+};
+
+
+//one step of a card's action list; a card only carries the steps it actually does, and runs them in order when played
+struct CardOp
+{
+	EffectDefinition const* m_effect = nullptr;
+	int						m_amount = 0;
+	int						m_count = 0;
+	TargetMode				m_targetMode = TargetMode::NONE;
+	CardOpCode				m_opCode = CardOpCode::DEAL;
+};
+
 
 class CardDefinition
 {
@@ -62,13 +90,18 @@ public:
 	//static functions
 	static void InitializeCardDefs();
 	static CardDefinition const* GetCardDefinition(std::string name);
+	static CardDefinition const* GetCardDefinition(CardDefHandle handle);
+	static CardDefHandle GetCardDefHandle(uint32_t index);	//invalid handle if the index is out of range
+	static TargetMode GetTargetModeFromName(std::string const& targetModeName);
+	static bool IsValidXml(XmlElement const& element, std::string& out_problem);	//checks everything the constructor dies on, without dying
 
 //public member variables
 public:
 	//card parameters
-	uint8_t		m_id = 0;
+	CardDefHandle m_handle;
 	std::string m_name = "invalid card";
 	Texture*	m_sprite = nullptr;
+	AABB2		m_spriteUVs = AABB2(0.0f, 0.0f, 1.0f, 1.0f);	//rect of m_sprite to draw, when it's an atlas page
 	CardType	m_type = CardType::INVALID;
 	CardRarity	m_rarity = CardRarity::INVALID;
 	TargetMode	m_targetMode = TargetMode::NONE;
@@ -90,7 +123,19 @@ public:
 	bool		m_isPlayable = true;
 
 	std::string m_description = "invalid description";
+	int			m_revision = 0;	//bumped each time the definition is hot reloaded
+
+	//what the card does when played, compiled at load from the parameters above or from an <Actions> child element
+	std::vector<CardOp> m_ops;
 
 	//static variables
 	static std::vector<CardDefinition> s_cardDefs;
+	static uint32_t s_registryGeneration;	//bumped each time s_cardDefs is rebuilt, handles from older generations are stale
+
+//private member functions
+private:
+	//op compilation functions
+	void CompileOpsFromParameters();
+	void CompileOpsFromActions(XmlElement const& actionsElement);
+	void AddOp(CardOpCode opCode, int amount, int count, TargetMode targetMode, EffectDefinition const* effect = nullptr);
 };
@@ -0,0 +1,79 @@
+#include "Game/CardLayout.hpp"
+
+
+//
+//public layout functions
+//
+AABB2 const& CardLayout::GetHandSlotBounds(int handIndex, int handSize) const
+{
+	if (handSize != m_cachedHandSize)
+	{
+		RebuildHandSlots(handSize);
+	}
+
+	return m_handSlotBounds[handIndex];
+}
+
+
+bool CardLayout::IsHandOverlapping(int handSize) const
+{
+	float rowWidth = (CARD_WIDTH + CARD_SPACING) * static_cast<float>(handSize) - CARD_SPACING;
+	return rowWidth > HAND_AREA_HALF_WIDTH * 2.0f;
+}
+
+
+//
+//public static functions
+//
+AABB2 CardLayout::GetRewardSlotBounds(int rewardIndex, int numRewards)
+{
+	float stride = CARD_WIDTH + REWARD_CARD_SPACING;
+	float rowWidth = stride * static_cast<float>(numRewards) - REWARD_CARD_SPACING;
+	float minX = SCREEN_CAMERA_CENTER_X - rowWidth * 0.5f + stride * static_cast<float>(rewardIndex);
+	float minY = SCREEN_CAMERA_CENTER_Y - CARD_HEIGHT * 0.5f;
+
+	return AABB2(minX, minY, minX + CARD_WIDTH, minY + CARD_HEIGHT);
+}
+
+
+//
+//private layout functions
+//
+void CardLayout::RebuildHandSlots(int handSize) const
+{
+	m_cachedHandSize = handSize;
+	m_handSlotBounds.resize(handSize);
+
+	if (handSize == 0)
+	{
+		return;
+	}
+
+	//use normal spacing if the whole row fits, otherwise squeeze the cards together until it does
+	float stride = CARD_WIDTH + CARD_SPACING;
+	float rowWidth = stride * static_cast<float>(handSize) - CARD_SPACING;
+	bool isOverlapping = IsHandOverlapping(handSize);
+	if (isOverlapping)
+	{
+		rowWidth = HAND_AREA_HALF_WIDTH * 2.0f;
+		stride = (rowWidth - CARD_WIDTH) / static_cast<float>(handSize - 1);
+	}
+
+	float firstMinX = SCREEN_CAMERA_CENTER_X - rowWidth * 0.5f;
+	float middleIndex = static_cast<float>(handSize - 1) * 0.5f;
+
+	for (int handIndex = 0; handIndex < handSize; handIndex++)
+	{
+		float minX = firstMinX + stride * static_cast<float>(handIndex);
+		float minY = HAND_BOTTOM_Y;
+
+		//fan overlapping hands by raising cards closer to the middle
+		if (isOverlapping)
+		{
+			float offsetFromMiddle = (static_cast<float>(handIndex) - middleIndex) / middleIndex;
+			minY += HAND_FAN_RISE * (1.0f - offsetFromMiddle * offsetFromMiddle);
+		}
+
+		m_handSlotBounds[handIndex] = AABB2(minX, minY, minX + CARD_WIDTH, minY + CARD_HEIGHT);
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include <vector>
+
+
+//constants
+constexpr float CARD_WIDTH = 160.0f;
+constexpr float CARD_HEIGHT = 240.0f;
+constexpr float CARD_SPACING = 20.0f;
+
+constexpr float HAND_BOTTOM_Y = 10.0f;
+constexpr float HAND_AREA_HALF_WIDTH = 600.0f;	//keeps the hand clear of the pile indicators and the end turn button
+constexpr float HAND_FAN_RISE = 15.0f;			//how far the middle card rises when the hand has to overlap
+
+constexpr float REWARD_CARD_SPACING = 120.0f;
+
+
+//computes where cards go for any hand size
+//hand slots sit in a centered row while they fit, and overlap into a shallow fan once they don't
+//slot bounds are cached until the hand size changes, and rendering and hit-testing both read the cache
+class CardLayout
+{
+//public member functions
+public:
+	//layout functions
+	AABB2 const& GetHandSlotBounds(int handIndex, int handSize) const;
+	bool IsHandOverlapping(int handSize) const;
+
+	//static functions
+	static AABB2 GetRewardSlotBounds(int rewardIndex, int numRewards);
+
+//private member functions
+private:
+	void RebuildHandSlots(int handSize) const;
+
+//private member variables
+private:
+	mutable int m_cachedHandSize = -1;
+	mutable std::vector<AABB2> m_handSlotBounds;
+};
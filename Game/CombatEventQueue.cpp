@@ -0,0 +1,66 @@
+#include "Game/CombatEventQueue.hpp"
+
+
+//constants
+constexpr unsigned int COMBAT_EVENT_QUEUE_MASK = COMBAT_EVENT_QUEUE_CAPACITY - 1;
+static_assert((COMBAT_EVENT_QUEUE_CAPACITY & COMBAT_EVENT_QUEUE_MASK) == 0, "COMBAT_EVENT_QUEUE_CAPACITY must be a power of two");
+
+
+//
+//public producer functions
+//
+bool CombatEventQueue::Push(CombatEvent const& event)
+{
+	unsigned int writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+	unsigned int readIndex = m_readIndex.load(std::memory_order_acquire);
+
+	if (writeIndex - readIndex >= COMBAT_EVENT_QUEUE_CAPACITY)
+	{
+		m_numDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	m_events[writeIndex & COMBAT_EVENT_QUEUE_MASK] = event;
+	m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+	return true;
+}
+
+
+//
+//public consumer functions
+//
+bool CombatEventQueue::Pop(CombatEvent& out_event)
+{
+	unsigned int readIndex = m_readIndex.load(std::memory_order_relaxed);
+	unsigned int writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+	if (readIndex == writeIndex)
+	{
+		return false;
+	}
+
+	out_event = m_events[readIndex & COMBAT_EVENT_QUEUE_MASK];
+	m_readIndex.store(readIndex + 1, std::memory_order_release);
+	return true;
+}
+
+
+void CombatEventQueue::DropAll()
+{
+	m_readIndex.store(m_writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+
+//
+//public accessors
+//
+bool CombatEventQueue::IsEmpty() const
+{
+	return m_readIndex.load(std::memory_order_acquire) == m_writeIndex.load(std::memory_order_acquire);
+}
+
+
+int CombatEventQueue::GetNumDroppedEvents() const
+{
+	return m_numDroppedEvents.load(std::memory_order_relaxed);
+}
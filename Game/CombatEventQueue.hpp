@@ -0,0 +1,72 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include <atomic>
+#include <type_traits>
+
+
+//forward declarations
+class Enemy;
+class EffectDefinition;
+class CardDefinition;
+
+
+//constants
+constexpr unsigned int COMBAT_EVENT_QUEUE_CAPACITY = 1024;	//must be a power of two
+constexpr int CACHE_LINE_SIZE = 64;
+
+
+//what happened during combat; game state has already changed by the time an event is pushed
+enum class CombatEventType : unsigned char
+{
+	HIT,
+	BLOCK,
+	HEAL,
+	EFFECT_APPLIED,
+	DEBUFF_BLOCKED,
+	CARD_ADDED,
+	ENEMY_ACTED,	//one enemy's action begins, m_seconds is how long presentation should dwell on it
+	TURN_PAUSE,		//nothing happens for m_seconds
+};
+
+
+//plain data so the gameplay side can push it without formatting, allocating or knowing who consumes it
+struct CombatEvent
+{
+	Enemy*					m_enemy = nullptr;	//nullptr if the event is about the player
+	EffectDefinition const* m_effect = nullptr;
+	CardDefinition const*	m_card = nullptr;
+	int						m_amount = 0;
+	int						m_blockedAmount = 0;
+	float					m_seconds = 0.0f;
+	CombatEventType			m_type = CombatEventType::HIT;
+};
+static_assert(std::is_trivially_copyable<CombatEvent>::value, "CombatEvent must stay plain data");
+
+
+//preallocated single-producer single-consumer ring of combat events
+//gameplay pushes, and whoever presents (or ignores) combat pops, possibly from another thread
+//pushing into a full queue drops the event and counts it instead of blocking gameplay
+class CombatEventQueue
+{
+//public member functions
+public:
+	//producer functions
+	bool Push(CombatEvent const& event);
+
+	//consumer functions
+	bool Pop(CombatEvent& out_event);
+	void DropAll();
+
+	//accessors
+	bool IsEmpty() const;
+	int GetNumDroppedEvents() const;
+
+//private member variables
+private:
+	CombatEvent m_events[COMBAT_EVENT_QUEUE_CAPACITY];
+
+	//indices only ever increase and wrap through the mask; each side writes only its own index
+	alignas(CACHE_LINE_SIZE) std::atomic<unsigned int> m_writeIndex = 0;
+	alignas(CACHE_LINE_SIZE) std::atomic<unsigned int> m_readIndex = 0;
+	std::atomic<int> m_numDroppedEvents = 0;
+};
@@ -0,0 +1,268 @@
+#include "Game/CombatState.hpp"
+#include "Game/Player.hpp"
+#include "Game/Enemy.hpp"
+#include "Game/Encounter.hpp"
+#include "Game/CardDefinition.hpp"
+#include "Game/EffectDefinition.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+//the slot a card pointer refers to, or -1 for a card the player doesn't own (or nullptr)
+static int GetCardSlot(Player const& player, Card const* card)
+{
+	if (card == nullptr)
+	{
+		return -1;
+	}
+
+	int numDeckCards = static_cast<int>(player.m_deck.size());
+	if (numDeckCards > 0 && card >= &player.m_deck[0] && card < &player.m_deck[0] + numDeckCards)
+	{
+		return static_cast<int>(card - &player.m_deck[0]);
+	}
+
+	for (int addedIndex = 0; addedIndex < player.m_tempAddedCards.size(); addedIndex++)
+	{
+		if (player.m_tempAddedCards[addedIndex] == card)
+		{
+			return numDeckCards + addedIndex;
+		}
+	}
+
+	return -1;
+}
+
+
+static Card* GetSlotCard(Player& player, int cardSlot)
+{
+	int numDeckCards = static_cast<int>(player.m_deck.size());
+	if (cardSlot < numDeckCards)
+	{
+		return &player.m_deck[cardSlot];
+	}
+
+	return player.m_tempAddedCards[cardSlot - numDeckCards];
+}
+
+
+static bool CapturePile(Player const& player, std::vector<Card*> const& pile, uint8_t* out_cardSlots, int& numCardSlots)
+{
+	if (numCardSlots + static_cast<int>(pile.size()) > COMBAT_STATE_MAX_CARDS)
+	{
+		return false;
+	}
+
+	for (int cardIndex = 0; cardIndex < pile.size(); cardIndex++)
+	{
+		int cardSlot = GetCardSlot(player, pile[cardIndex]);
+		if (cardSlot < 0)
+		{
+			return false;
+		}
+
+		out_cardSlots[numCardSlots] = static_cast<uint8_t>(cardSlot);
+		numCardSlots++;
+	}
+
+	return true;
+}
+
+
+static void RestorePile(Player& player, std::vector<Card*>& pile, uint8_t const* cardSlots, int firstSlotIndex, int pileSize)
+{
+	//cleared rather than freed, so restoring into piles that have held this many cards before doesn't allocate
+	pile.clear();
+	for (int cardIndex = 0; cardIndex < pileSize; cardIndex++)
+	{
+		pile.emplace_back(GetSlotCard(player, cardSlots[firstSlotIndex + cardIndex]));
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool CaptureActor(CombatActorState& out_actor, int currentHealth, int currentBlock, std::vector<Effect> const& effects)
+{
+	if (effects.size() > COMBAT_STATE_MAX_EFFECTS)
+	{
+		return false;
+	}
+
+	out_actor.m_currentHealth = currentHealth;
+	out_actor.m_currentBlock = currentBlock;
+	out_actor.m_isPresent = true;
+	out_actor.m_numEffects = static_cast<uint8_t>(effects.size());
+
+	for (int effectIndex = 0; effectIndex < effects.size(); effectIndex++)
+	{
+		Effect const& effect = effects[effectIndex];
+		CombatEffectState& effectState = out_actor.m_effects[effectIndex];
+		effectState.m_definitionIndex = static_cast<int16_t>(effect.m_definition - EffectDefinition::s_effectDefs.data());
+		effectState.m_stack = effect.m_stack;
+		effectState.m_justAdded = effect.m_justAdded;
+	}
+
+	return true;
+}
+
+
+static void RestoreEffects(CombatActorState const& actor, std::vector<Effect>& effects, EffectTriggerLists& effectTriggers, Player* playerOwner, Enemy* enemyOwner)
+{
+	effects.clear();
+	for (int effectIndex = 0; effectIndex < actor.m_numEffects; effectIndex++)
+	{
+		CombatEffectState const& effectState = actor.m_effects[effectIndex];
+		Effect effect = Effect(&EffectDefinition::s_effectDefs[effectState.m_definitionIndex], effectState.m_stack, playerOwner, enemyOwner);
+		effect.m_justAdded = effectState.m_justAdded;
+		effects.emplace_back(effect);
+	}
+
+	effectTriggers.Rebuild(effects);
+}
+
+
+//
+//public member functions
+//
+bool CombatState::Capture(Player const& player, Encounter const& encounter)
+{
+	m_rngSeed = g_rng.m_seed;
+	m_rngPosition = g_rng.m_position;
+
+	//encounter
+	if (encounter.m_currentEnemies.size() > COMBAT_STATE_MAX_ENEMIES)
+	{
+		return false;
+	}
+
+	m_turnNumber = encounter.m_turnNumber;
+	m_turnState = static_cast<uint8_t>(encounter.m_turnState);
+	m_numEnemies = static_cast<uint8_t>(encounter.m_currentEnemies.size());
+	m_isCardRewardScreenOpen = encounter.m_cardRewardScreenOpen;
+
+	//player
+	m_maxHealth = player.m_maxHealth;
+	m_currentEnergy = player.m_currentEnergy;
+	m_startEnergy = player.m_startEnergy;
+	if (!CaptureActor(m_player, player.m_currentHealth, player.m_currentBlock, player.m_effects))
+	{
+		return false;
+	}
+
+	//cards
+	if (player.m_deck.size() + player.m_tempAddedCards.size() > COMBAT_STATE_MAX_CARDS || player.m_tempAddedCards.size() > COMBAT_STATE_MAX_ADDED_CARDS)
+	{
+		return false;
+	}
+
+	m_numDeckCards = static_cast<uint8_t>(player.m_deck.size());
+	m_numAddedCards = static_cast<uint8_t>(player.m_tempAddedCards.size());
+	for (int addedIndex = 0; addedIndex < player.m_tempAddedCards.size(); addedIndex++)
+	{
+		m_addedCardDefinitionIndices[addedIndex] = static_cast<int16_t>(player.m_tempAddedCards[addedIndex]->m_definition->m_handle.GetIndex());
+	}
+
+	int numCardSlots = 0;
+	if (!CapturePile(player, player.m_drawPile, m_pileCardSlots, numCardSlots))
+	{
+		return false;
+	}
+	m_drawPileSize = static_cast<uint8_t>(player.m_drawPile.size());
+
+	if (!CapturePile(player, player.m_hand, m_pileCardSlots, numCardSlots))
+	{
+		return false;
+	}
+	m_handSize = static_cast<uint8_t>(player.m_hand.size());
+
+	if (!CapturePile(player, player.m_discardPile, m_pileCardSlots, numCardSlots))
+	{
+		return false;
+	}
+	m_discardPileSize = static_cast<uint8_t>(player.m_discardPile.size());
+
+	m_selectedCardSlot = static_cast<int16_t>(GetCardSlot(player, player.m_selectedCard));
+
+	//enemies
+	for (int enemyIndex = 0; enemyIndex < encounter.m_currentEnemies.size(); enemyIndex++)
+	{
+		Enemy const* enemy = encounter.m_currentEnemies[enemyIndex];
+		if (enemy == nullptr)
+		{
+			m_enemies[enemyIndex] = CombatActorState();
+			continue;
+		}
+
+		if (!CaptureActor(m_enemies[enemyIndex], enemy->m_currentHealth, enemy->m_currentBlock, enemy->m_effects))
+		{
+			return false;
+		}
+		m_enemies[enemyIndex].m_currentIntentionIndex = static_cast<int16_t>(enemy->m_currentIntentionIndex);
+	}
+
+	return true;
+}
+
+
+void CombatState::Restore(Player& player, Encounter& encounter) const
+{
+	GUARANTEE_OR_DIE(player.m_deck.size() == m_numDeckCards, "Combat state was captured with a different deck");
+	GUARANTEE_OR_DIE(encounter.m_currentEnemies.size() == m_numEnemies, "Combat state was captured in a different encounter");
+
+	g_rng.m_seed = m_rngSeed;
+	g_rng.m_position = m_rngPosition;
+
+	//encounter
+	encounter.m_turnNumber = m_turnNumber;
+	encounter.m_turnState = static_cast<TurnState>(m_turnState);
+	encounter.m_cardRewardScreenOpen = m_isCardRewardScreenOpen;
+
+	//player
+	player.m_maxHealth = m_maxHealth;
+	player.m_currentEnergy = m_currentEnergy;
+	player.m_startEnergy = m_startEnergy;
+	player.m_currentHealth = m_player.m_currentHealth;
+	player.m_currentBlock = m_player.m_currentBlock;
+	RestoreEffects(m_player, player.m_effects, player.m_effectTriggers, &player, nullptr);
+
+	//cards added since the capture are freed, and ones added before it but freed since are recreated; the rest keep their addresses
+	while (player.m_tempAddedCards.size() > m_numAddedCards)
+	{
+		delete player.m_tempAddedCards.back();
+		player.m_tempAddedCards.pop_back();
+	}
+	for (int addedIndex = 0; addedIndex < m_numAddedCards; addedIndex++)
+	{
+		CardDefinition const* definition = &CardDefinition::s_cardDefs[m_addedCardDefinitionIndices[addedIndex]];
+		if (addedIndex < player.m_tempAddedCards.size())
+		{
+			player.m_tempAddedCards[addedIndex]->m_definition = definition;
+		}
+		else
+		{
+			player.m_tempAddedCards.emplace_back(new Card(definition, &player));
+		}
+	}
+
+	RestorePile(player, player.m_drawPile, m_pileCardSlots, 0, m_drawPileSize);
+	RestorePile(player, player.m_hand, m_pileCardSlots, m_drawPileSize, m_handSize);
+	RestorePile(player, player.m_discardPile, m_pileCardSlots, m_drawPileSize + m_handSize, m_discardPileSize);
+	player.m_selectedCard = (m_selectedCardSlot >= 0) ? GetSlotCard(player, m_selectedCardSlot) : nullptr;
+
+	//enemies
+	for (int enemyIndex = 0; enemyIndex < m_numEnemies; enemyIndex++)
+	{
+		Enemy* enemy = encounter.m_currentEnemies[enemyIndex];
+		CombatActorState const& enemyState = m_enemies[enemyIndex];
+		if (enemy == nullptr || !enemyState.m_isPresent)
+		{
+			continue;
+		}
+
+		enemy->m_currentHealth = enemyState.m_currentHealth;
+		enemy->m_currentBlock = enemyState.m_currentBlock;
+		enemy->m_currentIntentionIndex = enemyState.m_currentIntentionIndex;
+		RestoreEffects(enemyState, enemy->m_effects, enemy->m_effectTriggers, nullptr, enemy);
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include <cstdint>
+#include <type_traits>
+
+
+//forward declarations
+class Player;
+class Encounter;
+
+
+//constants
+constexpr int COMBAT_STATE_MAX_CARDS = 96;		//deck cards plus cards added during the fight, across all three piles
+constexpr int COMBAT_STATE_MAX_ADDED_CARDS = 32;
+constexpr int COMBAT_STATE_MAX_EFFECTS = 8;		//per actor
+constexpr int COMBAT_STATE_MAX_ENEMIES = 5;
+
+
+//one effect on an actor; the definition is its index in s_effectDefs
+struct CombatEffectState
+{
+	int		m_stack = 0;
+	int16_t m_definitionIndex = -1;
+	bool	m_justAdded = false;
+};
+
+
+//the rules state of the player or one enemy
+struct CombatActorState
+{
+	int				  m_currentHealth = 0;
+	int				  m_currentBlock = 0;
+	int16_t			  m_currentIntentionIndex = 0;	//enemies only
+	bool			  m_isPresent = false;			//enemy slots can be empty
+	uint8_t			  m_numEffects = 0;
+	CombatEffectState m_effects[COMBAT_STATE_MAX_EFFECTS];
+};
+
+
+//everything the rules read and write during one encounter's fight, with no pointers in it, so a state is copied with one memcpy
+//cards are slots: slot i below m_numDeckCards is m_deck[i], the slots after it are the player's m_tempAddedCards in order
+//the piles are stored back to back (draw pile, then hand, then discard pile) as slots
+//the deck itself, enemy definitions and the card rewards don't change mid-fight, so they aren't copied, only checked on restore
+//presentation (labels, layers, combat events and timelines) isn't part of the state and catches up on its own
+struct CombatState
+{
+//public member functions
+public:
+	bool Capture(Player const& player, Encounter const& encounter);	//false if the fight doesn't fit in the fixed capacities
+	void Restore(Player& player, Encounter& encounter) const;
+
+//public member variables
+public:
+	//rng, so a restored state rolls the same numbers it rolled the first time
+	unsigned int m_rngSeed = 0;
+	int			 m_rngPosition = 0;
+
+	//encounter
+	int		m_turnNumber = 0;
+	uint8_t m_turnState = 0;
+	uint8_t m_numEnemies = 0;
+	bool	m_isCardRewardScreenOpen = false;	//a fork that wins the fight opens it, so restoring has to close it again
+
+	//player
+	int				 m_maxHealth = 0;
+	int				 m_currentEnergy = 0;
+	int				 m_startEnergy = 0;
+	CombatActorState m_player;
+
+	//cards
+	uint8_t m_numDeckCards = 0;
+	uint8_t m_numAddedCards = 0;
+	int16_t m_addedCardDefinitionIndices[COMBAT_STATE_MAX_ADDED_CARDS] = {};
+	uint8_t m_drawPileSize = 0;
+	uint8_t m_handSize = 0;
+	uint8_t m_discardPileSize = 0;
+	uint8_t m_pileCardSlots[COMBAT_STATE_MAX_CARDS] = {};
+	int16_t m_selectedCardSlot = -1;
+
+	//enemies
+	CombatActorState m_enemies[COMBAT_STATE_MAX_ENEMIES];
+};
+
+
+static_assert(std::is_trivially_copyable<CombatState>::value, "CombatState must stay copyable with memcpy");
@@ -0,0 +1,117 @@
+#include "Game/CombatTimeline.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/App.hpp"
+#include "Game/Game.hpp"
+#include "Game/Player.hpp"
+#include "Game/Enemy.hpp"
+
+
+//
+//public playback functions
+//
+void CombatTimeline::ConsumeEvents(CombatEventQueue& eventQueue)
+{
+	CombatEvent event;
+	while (eventQueue.Pop(event))
+	{
+		switch (event.m_type)
+		{
+		case CombatEventType::ENEMY_ACTED: BeginBeat(event.m_seconds); break;
+		case CombatEventType::TURN_PAUSE:  AddPause(event.m_seconds); break;
+		default:						   AddCue(event); break;
+		}
+	}
+}
+
+
+void CombatTimeline::Update(float deltaSeconds)
+{
+	if (!IsPlaying())
+	{
+		return;
+	}
+
+	m_currentTime += deltaSeconds;
+
+	while (m_nextCueIndex < m_cues.size() && m_cues[m_nextCueIndex].m_time <= m_currentTime)
+	{
+		CombatEvent const& event = m_cues[m_nextCueIndex].m_event;
+		if (event.m_enemy != nullptr)
+		{
+			event.m_enemy->PresentCombatEvent(event);
+		}
+		else
+		{
+			g_theGame->m_player->PresentCombatEvent(event);
+		}
+
+		m_nextCueIndex++;
+	}
+
+	if (m_nextCueIndex >= m_cues.size() && m_currentTime >= m_endTime)
+	{
+		Clear();
+	}
+}
+
+
+void CombatTimeline::Skip()
+{
+	//the game state is already final, so skipping just drops whatever hasn't been shown yet
+	Clear();
+}
+
+
+void CombatTimeline::Clear()
+{
+	m_cues.clear();
+	m_nextCueIndex = 0;
+	m_currentTime = 0.0f;
+	m_nextCueTime = 0.0f;
+	m_endTime = 0.0f;
+	m_hasBeats = false;
+}
+
+
+//
+//public accessors
+//
+bool CombatTimeline::IsPlaying() const
+{
+	return m_nextCueIndex < m_cues.size() || m_currentTime < m_endTime;
+}
+
+
+//
+//private timeline building functions
+//
+void CombatTimeline::AddCue(CombatEvent const& event)
+{
+	CombatCue cue;
+	cue.m_event = event;
+	cue.m_time = m_nextCueTime;
+	m_cues.emplace_back(cue);
+
+	if (m_endTime < m_nextCueTime)
+	{
+		m_endTime = m_nextCueTime;
+	}
+}
+
+
+void CombatTimeline::BeginBeat(float beatSeconds)
+{
+	//a beat waits for everything already queued, then its cues play together
+	float beatStartTime = (m_endTime > m_currentTime) ? m_endTime : m_currentTime;
+	m_nextCueTime = beatStartTime + beatSeconds;
+	m_endTime = m_nextCueTime;
+	m_hasBeats = true;
+}
+
+
+void CombatTimeline::AddPause(float pauseSeconds)
+{
+	float pauseStartTime = (m_endTime > m_currentTime) ? m_endTime : m_currentTime;
+	m_endTime = pauseStartTime + pauseSeconds;
+	m_nextCueTime = m_endTime;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Game/CombatEventQueue.hpp"
+#include <vector>
+
+
+//constants
+constexpr float PLAYBACK_RATE_UNCAPPED = -1.0f;	//as many logic ticks per frame as the cpu allows while there's something to fast-forward
+constexpr int NUM_PLAYBACK_RATES = 6;
+constexpr float PLAYBACK_RATES[NUM_PLAYBACK_RATES] = { 1.0f, 2.0f, 5.0f, 10.0f, PLAYBACK_RATE_UNCAPPED, 0.0f };	//0 skips presentation entirely
+
+
+//a combat event and when the timeline will present it
+struct CombatCue
+{
+	CombatEvent m_event;
+	float		m_time = 0.0f;
+};
+
+
+//queue of presentation cues played back over time after the logic that produced them has already resolved
+//events consumed outside a beat play on the next update; events after an ENEMY_ACTED wait for that beat
+class CombatTimeline
+{
+//public member functions
+public:
+	//playback functions
+	void ConsumeEvents(CombatEventQueue& eventQueue);
+	void Update(float deltaSeconds);
+	void Skip();
+	void Clear();
+
+	//accessors
+	bool IsPlaying() const;
+	bool IsPlayingBeats() const { return m_hasBeats && IsPlaying(); }
+
+//private member functions
+private:
+	//timeline building functions
+	void AddCue(CombatEvent const& event);
+	void BeginBeat(float beatSeconds);
+	void AddPause(float pauseSeconds);
+
+//private member variables
+private:
+	std::vector<CombatCue> m_cues;
+	int	  m_nextCueIndex = 0;
+	float m_currentTime = 0.0f;
+	float m_nextCueTime = 0.0f;
+	float m_endTime = 0.0f;
+	bool  m_hasBeats = false;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <cstdint>
+
+
+//typed index into one of the definition registries (s_cardDefs, s_encounterDefs, ...)
+//the type parameter only keeps handles to different registries from being mixed up; release builds carry just the index,
+//debug builds also carry the generation of the registry the handle was made from and check it on every lookup,
+//so a handle that outlived its registry being rebuilt fails loudly instead of quietly pointing at a different definition
+template <typename DefinitionType>
+class DefinitionHandle
+{
+//public member functions
+public:
+	//constructors
+	DefinitionHandle() {}
+	explicit DefinitionHandle(uint32_t index, uint32_t registryGeneration)
+		: m_index(index)
+#if defined(_DEBUG)
+		, m_generation(registryGeneration)
+#endif
+	{
+		UNUSED(registryGeneration);
+	}
+
+	//accessors
+	bool	 IsValid() const  { return m_index != INVALID_INDEX; }
+	uint32_t GetIndex() const { return m_index; }
+
+	//validation
+	void CheckGeneration(uint32_t registryGeneration) const
+	{
+#if defined(_DEBUG)
+		GUARANTEE_OR_DIE(m_generation == registryGeneration, "Stale definition handle: its registry was rebuilt after the handle was made!");
+#endif
+		UNUSED(registryGeneration);
+	}
+
+	//operators
+	bool operator==(DefinitionHandle const& compare) const { return m_index == compare.m_index; }
+	bool operator!=(DefinitionHandle const& compare) const { return m_index != compare.m_index; }
+
+//public member variables
+public:
+	static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+//private member variables
+private:
+	uint32_t m_index = INVALID_INDEX;
+#if defined(_DEBUG)
+	uint32_t m_generation = 0;
+#endif
+};
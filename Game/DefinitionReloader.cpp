@@ -0,0 +1,317 @@
+#include "Game/DefinitionReloader.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/Game.hpp"
+#include "Game/App.hpp"
+#include "Game/Map.hpp"
+#include "Game/Encounter.hpp"
+#include "Game/Player.hpp"
+#include "Game/Enemy.hpp"
+#include "Game/EffectDefinition.hpp"
+#include "Game/CardDefinition.hpp"
+#include "Game/EnemyDefinition.hpp"
+#include "Game/EncounterDefinition.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#include <functional>
+
+
+//
+//public game flow functions
+//
+void DefinitionReloader::Startup()
+{
+	m_files[static_cast<int>(DefinitionKind::EFFECT)].m_filePath = "Data/Definitions/EffectDefinitions.xml";
+	m_files[static_cast<int>(DefinitionKind::CARD)].m_filePath = "Data/Definitions/CardDefinitions.xml";
+	m_files[static_cast<int>(DefinitionKind::ENEMY)].m_filePath = "Data/Definitions/EnemyDefinitions.xml";
+	m_files[static_cast<int>(DefinitionKind::ENCOUNTER)].m_filePath = "Data/Definitions/EncounterDefinitions.xml";
+
+	//record what's on disk now, so only later edits get patched in
+	for (int fileIndex = 0; fileIndex < static_cast<int>(DefinitionKind::COUNT); fileIndex++)
+	{
+		WatchedDefinitionFile& file = m_files[fileIndex];
+		file.m_kind = static_cast<DefinitionKind>(fileIndex);
+
+		std::error_code error;
+		file.m_lastWriteTime = std::filesystem::last_write_time(file.m_filePath, error);
+
+		XmlDocument document;
+		if (document.LoadFile(file.m_filePath) != tinyxml2::XML_SUCCESS || document.RootElement() == nullptr)
+		{
+			continue;
+		}
+
+		XmlElement const* element = document.RootElement()->FirstChildElement();
+		while (element != nullptr)
+		{
+			file.m_elementHashes.emplace_back(HashElement(*element));
+			file.m_elementNames.emplace_back(ParseXmlAttribute(*element, "name", ""));
+			element = element->NextSiblingElement();
+		}
+	}
+
+	m_nextPollTime = GetCurrentTimeSeconds() + DEFINITION_RELOAD_POLL_SECONDS;
+	m_isStarted = true;
+}
+
+
+void DefinitionReloader::Update()
+{
+	if (!m_isStarted)
+	{
+		return;
+	}
+
+	double currentTime = GetCurrentTimeSeconds();
+	if (currentTime < m_nextPollTime)
+	{
+		return;
+	}
+	m_nextPollTime = currentTime + DEFINITION_RELOAD_POLL_SECONDS;
+
+	ReloadChangedFiles();
+}
+
+
+//
+//public reload functions
+//
+int DefinitionReloader::ReloadChangedFiles()
+{
+	double startTime = GetCurrentTimeSeconds();
+
+	int numPatched = 0;
+	bool effectsPatched = false;
+	for (int fileIndex = 0; fileIndex < static_cast<int>(DefinitionKind::COUNT); fileIndex++)
+	{
+		int numPatchedInFile = ReloadFile(m_files[fileIndex]);
+		numPatched += numPatchedInFile;
+
+		if (m_files[fileIndex].m_kind == DefinitionKind::EFFECT && numPatchedInFile > 0)
+		{
+			effectsPatched = true;
+		}
+	}
+
+	//an effect's triggers may have changed, and the live trigger lists were bucketed by the old ones
+	if (effectsPatched)
+	{
+		RebuildLiveEffectTriggers();
+	}
+
+	if (numPatched > 0)
+	{
+		double reloadMilliseconds = (GetCurrentTimeSeconds() - startTime) * 1000.0;
+		DebugAddMessage(Stringf("Reloaded %i definition(s) in %.1f ms", numPatched, reloadMilliseconds), 3.0f, Rgba8(0, 255, 0), Rgba8(0, 255, 0));
+	}
+
+	return numPatched;
+}
+
+
+//
+//private reload sub-functions
+//
+int DefinitionReloader::ReloadFile(WatchedDefinitionFile& file)
+{
+	std::error_code error;
+	std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(file.m_filePath, error);
+	if (error || writeTime == file.m_lastWriteTime)
+	{
+		return 0;
+	}
+	file.m_lastWriteTime = writeTime;
+
+	//a file caught halfway through being saved fails to parse; the save finishing bumps the write time again
+	XmlDocument document;
+	if (document.LoadFile(file.m_filePath) != tinyxml2::XML_SUCCESS || document.RootElement() == nullptr)
+	{
+		ERROR_RECOVERABLE(Stringf("Failed to parse %s, keeping the previous definitions", file.m_filePath));
+		return 0;
+	}
+
+	//definitions are patched in their existing slots, so the file must still list the same definitions in the same order
+	std::vector<XmlElement const*> elements;
+	XmlElement const* element = document.RootElement()->FirstChildElement();
+	while (element != nullptr)
+	{
+		elements.emplace_back(element);
+		element = element->NextSiblingElement();
+	}
+
+	bool isSameDefinitionList = elements.size() == file.m_elementNames.size();
+	for (int elementIndex = 0; elementIndex < elements.size() && isSameDefinitionList; elementIndex++)
+	{
+		isSameDefinitionList = ParseXmlAttribute(*elements[elementIndex], "name", "") == file.m_elementNames[elementIndex];
+	}
+
+	if (!isSameDefinitionList)
+	{
+		ERROR_RECOVERABLE(Stringf("%s gained, lost, renamed or reordered definitions; nothing in it was reloaded, restart to pick those up", file.m_filePath));
+		return 0;
+	}
+
+	//only definitions that were actually patched take their new hash, so one that failed is retried on the next save
+	int numPatched = 0;
+	for (int elementIndex = 0; elementIndex < elements.size(); elementIndex++)
+	{
+		size_t elementHash = HashElement(*elements[elementIndex]);
+		if (elementHash == file.m_elementHashes[elementIndex])
+		{
+			continue;
+		}
+
+		if (PatchDefinition(file.m_kind, elementIndex, *elements[elementIndex]))
+		{
+			file.m_elementHashes[elementIndex] = elementHash;
+			numPatched++;
+		}
+	}
+
+	return numPatched;
+}
+
+
+bool DefinitionReloader::PatchDefinition(DefinitionKind kind, int elementIndex, XmlElement const& element)
+{
+	//bad data keeps the previous definition; the constructors below die on anything IsValidDefinitionXml lets through
+	std::string problem;
+	if (!IsValidDefinitionXml(kind, element, problem))
+	{
+		ERROR_RECOVERABLE(Stringf("%s; keeping the previous definition", problem.c_str()));
+		return false;
+	}
+
+	//encounters have no name and are looked up by position, everything else by name
+	std::string name = ParseXmlAttribute(element, "name", "");
+
+	switch (kind)
+	{
+	case DefinitionKind::EFFECT:
+	{
+		for (int defIndex = 0; defIndex < EffectDefinition::s_effectDefs.size(); defIndex++)
+		{
+			if (EffectDefinition::s_effectDefs[defIndex].m_name == name)
+			{
+				EffectDefinition patchedDef = EffectDefinition(element);
+				EffectDefinition::s_effectDefs[defIndex] = patchedDef;
+				return true;
+			}
+		}
+		break;
+	}
+	case DefinitionKind::CARD:
+	{
+		for (int defIndex = 0; defIndex < CardDefinition::s_cardDefs.size(); defIndex++)
+		{
+			CardDefinition& cardDef = CardDefinition::s_cardDefs[defIndex];
+			if (cardDef.m_name == name)
+			{
+				CardDefinition patchedDef = CardDefinition(element);
+				patchedDef.m_handle = cardDef.m_handle;
+				patchedDef.m_revision = cardDef.m_revision + 1;
+				cardDef = patchedDef;
+				return true;
+			}
+		}
+		break;
+	}
+	case DefinitionKind::ENEMY:
+	{
+		for (int defIndex = 0; defIndex < EnemyDefinition::s_enemyDefs.size(); defIndex++)
+		{
+			EnemyDefinition& enemyDef = EnemyDefinition::s_enemyDefs[defIndex];
+			if (enemyDef.m_name == name)
+			{
+				EnemyDefinition patchedDef = EnemyDefinition(element);
+				patchedDef.m_revision = enemyDef.m_revision + 1;
+				enemyDef = patchedDef;
+				return true;
+			}
+		}
+		break;
+	}
+	case DefinitionKind::ENCOUNTER:
+	{
+		if (elementIndex < EncounterDefinition::s_encounterDefs.size())
+		{
+			EncounterDefinition& encounterDef = EncounterDefinition::s_encounterDefs[elementIndex];
+			EncounterDefinition patchedDef = EncounterDefinition(element);
+			patchedDef.m_handle = encounterDef.m_handle;
+			encounterDef = patchedDef;
+			return true;
+		}
+		return false;
+	}
+	default:
+		return false;
+	}
+
+	ERROR_RECOVERABLE(Stringf("No loaded definition named \"%s\" to reload; restart to add new definitions", name.c_str()));
+	return false;
+}
+
+
+void DefinitionReloader::RebuildLiveEffectTriggers() const
+{
+	if (g_theGame->m_player != nullptr)
+	{
+		g_theGame->m_player->m_effectTriggers.Rebuild(g_theGame->m_player->m_effects);
+	}
+
+	if (g_theGame->m_map == nullptr)
+	{
+		return;
+	}
+
+	for (int encounterIndex = 0; encounterIndex < g_theGame->m_map->m_allEncounters.size(); encounterIndex++)
+	{
+		Encounter* encounter = g_theGame->m_map->m_allEncounters[encounterIndex];
+		if (encounter == nullptr)
+		{
+			continue;
+		}
+
+		for (int enemyIndex = 0; enemyIndex < encounter->m_currentEnemies.size(); enemyIndex++)
+		{
+			Enemy* enemy = encounter->m_currentEnemies[enemyIndex];
+			if (enemy != nullptr)
+			{
+				enemy->m_effectTriggers.Rebuild(enemy->m_effects);
+			}
+		}
+	}
+}
+
+
+//
+//private static functions
+//
+size_t DefinitionReloader::HashElement(XmlElement const& element)
+{
+	tinyxml2::XMLPrinter printer(nullptr, true);
+	element.Accept(&printer);
+	return std::hash<std::string>()(std::string(printer.CStr()));
+}
+
+
+bool DefinitionReloader::IsValidDefinitionXml(DefinitionKind kind, XmlElement const& element, std::string& out_problem)
+{
+	static char const* const s_elementNames[static_cast<int>(DefinitionKind::COUNT)] = { "EffectDefinition", "CardDefinition", "EnemyDefinition", "EncounterDefinition" };
+
+	std::string elementName = element.Name();
+	if (elementName != s_elementNames[static_cast<int>(kind)])
+	{
+		out_problem = Stringf("<%s> found where an <%s> belongs", elementName.c_str(), s_elementNames[static_cast<int>(kind)]);
+		return false;
+	}
+
+	switch (kind)
+	{
+	case DefinitionKind::CARD:		return CardDefinition::IsValidXml(element, out_problem);
+	case DefinitionKind::ENEMY:		return EnemyDefinition::IsValidXml(element, out_problem);
+	case DefinitionKind::ENCOUNTER: return EncounterDefinition::IsValidXml(element, out_problem);
+	default:						return true;	//nothing in an effect definition is fatal
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+//constants
+constexpr double DEFINITION_RELOAD_POLL_SECONDS = 0.05;	//file check interval; a saved edit is live within this plus one parse
+
+
+//which definition list a watched file feeds
+enum class DefinitionKind
+{
+	EFFECT,
+	CARD,
+	ENEMY,
+	ENCOUNTER,
+	COUNT
+};
+
+
+//what the reloader last saw of one definition file
+struct WatchedDefinitionFile
+{
+	DefinitionKind					m_kind = DefinitionKind::COUNT;
+	char const*						m_filePath = nullptr;
+	std::filesystem::file_time_type m_lastWriteTime;
+	std::vector<size_t>				m_elementHashes;	//hash of each loaded definition element's xml, in file order
+	std::vector<std::string>		m_elementNames;		//name of each definition element, in file order; encounters have none
+};
+
+
+//watches the definition xml files and re-parses only the definitions whose xml changed
+//changed definitions are overwritten in their existing slot of the s_xxxDefs vectors, which are never resized while running,
+//so every pointer the game holds into them (cards, enemies, effects, encounter setups) stays valid across a reload
+//a file whose definitions were added, removed, renamed or reordered is refused whole; that still needs a restart
+//a definition whose xml doesn't validate keeps its previous version, so a typo saved mid-game only costs a warning
+class DefinitionReloader
+{
+//public member functions
+public:
+	//game flow functions
+	void Startup();
+	void Update();
+
+	//reload functions
+	int ReloadChangedFiles();	//returns the number of definitions that were patched
+
+//private member functions
+private:
+	//reload sub-functions
+	int ReloadFile(WatchedDefinitionFile& file);
+	bool PatchDefinition(DefinitionKind kind, int elementIndex, XmlElement const& element);
+	void RebuildLiveEffectTriggers() const;
+
+	//static functions
+	static size_t HashElement(XmlElement const& element);
+	static bool IsValidDefinitionXml(DefinitionKind kind, XmlElement const& element, std::string& out_problem);
+
+//private member variables
+private:
+	WatchedDefinitionFile m_files[static_cast<int>(DefinitionKind::COUNT)];	//in dependency order, so reloaded cards see reloaded effects
+	double				  m_nextPollTime = 0.0;
+	bool				  m_isStarted = false;
+};
@@ -19,3 +19,74 @@ bool Effect::operator==(Effect const& otherEffect) const
 {
 	return m_definition->m_name == otherEffect.m_definition->m_name;
 }
+
+
+//
+//public list maintenance functions
+//
+void EffectTriggerLists::OnEffectAdded(std::vector<Effect> const& effects, int effectIndex)
+{
+	EffectDefinition const* definition = effects[effectIndex].m_definition;
+
+	for (int triggerIndex = 0; triggerIndex < static_cast<int>(EffectTrigger::COUNT); triggerIndex++)
+	{
+		if (definition->HasTrigger(static_cast<EffectTrigger>(triggerIndex)))
+		{
+			m_effectIndices[triggerIndex].emplace_back(effectIndex);
+		}
+	}
+}
+
+
+void EffectTriggerLists::Rebuild(std::vector<Effect> const& effects)
+{
+	Clear();
+
+	for (int effectIndex = 0; effectIndex < effects.size(); effectIndex++)
+	{
+		OnEffectAdded(effects, effectIndex);
+	}
+}
+
+
+void EffectTriggerLists::Clear()
+{
+	for (int triggerIndex = 0; triggerIndex < static_cast<int>(EffectTrigger::COUNT); triggerIndex++)
+	{
+		m_effectIndices[triggerIndex].clear();
+	}
+}
+
+
+//
+//public dispatch functions
+//
+int EffectTriggerLists::ApplyAmountModifiers(std::vector<Effect> const& effects, EffectTrigger trigger, int amount) const
+{
+	std::vector<int> const& effectIndices = m_effectIndices[static_cast<int>(trigger)];
+
+	for (int listIndex = 0; listIndex < effectIndices.size(); listIndex++)
+	{
+		Effect const& effect = effects[effectIndices[listIndex]];
+
+		if (effect.m_definition->m_usePercentage)
+		{
+			amount = static_cast<int>(static_cast<float>(amount) * effect.m_definition->m_percentModifier);
+		}
+		else
+		{
+			amount += effect.m_stack;
+		}
+	}
+
+	return amount;
+}
+
+
+//
+//public accessors
+//
+std::vector<int> const& EffectTriggerLists::GetEffectIndices(EffectTrigger trigger) const
+{
+	return m_effectIndices[static_cast<int>(trigger)];
+}
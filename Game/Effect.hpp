@@ -1,5 +1,6 @@
 #pragma once
 #include "Game/EffectDefinition.hpp"
+#include <vector>
 
 
 //forward declarations
@@ -29,3 +30,26 @@ public:
 
 	bool m_justAdded = true;
 };
+
+
+//per-actor lists of which of its effects respond to each trigger, as indices into the actor's effect vector
+//appending an effect only touches the lists it triggers on; removing effects shifts indices, so the lists are rebuilt
+class EffectTriggerLists
+{
+//public member functions
+public:
+	//list maintenance functions
+	void OnEffectAdded(std::vector<Effect> const& effects, int effectIndex);
+	void Rebuild(std::vector<Effect> const& effects);
+	void Clear();
+
+	//dispatch functions
+	int ApplyAmountModifiers(std::vector<Effect> const& effects, EffectTrigger trigger, int amount) const;
+
+	//accessors
+	std::vector<int> const& GetEffectIndices(EffectTrigger trigger) const;
+
+//private member variables
+private:
+	std::vector<int> m_effectIndices[static_cast<int>(EffectTrigger::COUNT)];
+};
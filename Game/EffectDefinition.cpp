@@ -1,4 +1,5 @@
 #include "Game/EffectDefinition.hpp"
+#include "Game/SpriteAtlas.hpp"
 #include "Game/GameCommon.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 
@@ -14,8 +15,12 @@ EffectDefinition::EffectDefinition(XmlElement const& element)
 {
 	m_name = ParseXmlAttribute(element, "name", m_name);
 
+#if !defined(GAME_HEADLESS)
 	std::string textureFilePath = ParseXmlAttribute(element, "sprite", "invalid file path");
-	m_sprite = g_theRenderer->CreateOrGetTextureFromFile(textureFilePath.c_str());
+	AtlasSprite sprite = g_spriteAtlas.GetSprite(textureFilePath);
+	m_sprite = sprite.m_texture;
+	m_spriteUVs = sprite.m_uvs;
+#endif
 
 	std::string typeString = ParseXmlAttribute(element, "type", "Invalid");
 	if (typeString == "Buff")
@@ -49,14 +54,58 @@ EffectDefinition::EffectDefinition(XmlElement const& element)
 		m_stackType = StackType::NONE;
 	}
 
-	m_modDealtDamage = ParseXmlAttribute(element, "modDealtDamage", m_modDealtDamage);
-	m_modReceivedDamage = ParseXmlAttribute(element, "modReceivedDamage", m_modReceivedDamage);
-	m_modBlock = ParseXmlAttribute(element, "modBlock", m_modBlock);
+	//triggers="OnDamageDealt,OnBlockGained" etc.
+	std::string triggersString = ParseXmlAttribute(element, "triggers", "");
+	Strings triggerNames = SplitStringOnDelimiter(triggersString, ',');
+	for (int nameIndex = 0; nameIndex < triggerNames.size(); nameIndex++)
+	{
+		std::string const& triggerName = triggerNames[nameIndex];
+		if (triggerName.empty())
+		{
+			continue;
+		}
+
+		EffectTrigger trigger = GetTriggerFromName(triggerName);
+		if (trigger == EffectTrigger::COUNT)
+		{
+			ERROR_RECOVERABLE(Stringf("Unknown trigger \"%s\" on effect %s", triggerName.c_str(), m_name.c_str()));
+			continue;
+		}
+		m_triggerFlags |= 1u << static_cast<unsigned int>(trigger);
+	}
+
+	//older definitions use one flag per behaviour instead of a trigger list
+	if (ParseXmlAttribute(element, "modDealtDamage", false))
+	{
+		m_triggerFlags |= 1u << static_cast<unsigned int>(EffectTrigger::DAMAGE_DEALT);
+	}
+	if (ParseXmlAttribute(element, "modReceivedDamage", false))
+	{
+		m_triggerFlags |= 1u << static_cast<unsigned int>(EffectTrigger::DAMAGE_RECEIVED);
+	}
+	if (ParseXmlAttribute(element, "modBlock", false))
+	{
+		m_triggerFlags |= 1u << static_cast<unsigned int>(EffectTrigger::BLOCK_GAINED);
+	}
+	if (ParseXmlAttribute(element, "blockDebuff", false))
+	{
+		m_triggerFlags |= 1u << static_cast<unsigned int>(EffectTrigger::DEBUFF_RECEIVED);
+	}
 
 	m_usePercentage = ParseXmlAttribute(element, "usePercentage", m_usePercentage);
 	m_percentModifier = ParseXmlAttribute(element, "percentModifier", m_percentModifier);
 
-	m_blockDebuff = ParseXmlAttribute(element, "blockDebuff", m_blockDebuff);
+	m_triggerDamage = ParseXmlAttribute(element, "triggerDamage", m_triggerDamage);
+	m_triggerBlock = ParseXmlAttribute(element, "triggerBlock", m_triggerBlock);
+}
+
+
+//
+//accessors
+//
+bool EffectDefinition::HasTrigger(EffectTrigger trigger) const
+{
+	return (m_triggerFlags & (1u << static_cast<unsigned int>(trigger))) != 0;
 }
 
 
@@ -85,6 +134,37 @@ void EffectDefinition::InitializeEffectDefs()
 }
 
 
+EffectTrigger EffectDefinition::GetTriggerFromName(std::string const& triggerName)
+{
+	if (triggerName == "OnDamageDealt")
+	{
+		return EffectTrigger::DAMAGE_DEALT;
+	}
+	else if (triggerName == "OnDamageReceived")
+	{
+		return EffectTrigger::DAMAGE_RECEIVED;
+	}
+	else if (triggerName == "OnBlockGained")
+	{
+		return EffectTrigger::BLOCK_GAINED;
+	}
+	else if (triggerName == "OnDebuffReceived")
+	{
+		return EffectTrigger::DEBUFF_RECEIVED;
+	}
+	else if (triggerName == "OnTurnStart")
+	{
+		return EffectTrigger::TURN_START;
+	}
+	else if (triggerName == "OnCardPlayed")
+	{
+		return EffectTrigger::CARD_PLAYED;
+	}
+
+	return EffectTrigger::COUNT;
+}
+
+
 EffectDefinition const* EffectDefinition::GetEffectDefinition(std::string name)
 {
 	for (int defIndex = 0; defIndex < s_effectDefs.size(); defIndex++)
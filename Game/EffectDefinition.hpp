@@ -16,7 +16,23 @@ enum class StackType
 	DURATION,
 	INTENSITY,
 	COUNTER, 
-	NONE
+	NONE,
+	COUNT
+};
+
+//moments an effect can respond to; what it does depends on the trigger:
+//	damage dealt, damage received and block gained modify the amount (by percentage, or by adding the stack)
+//	debuff received blocks the debuff and spends a stack
+//	turn start and card played apply the trigger damage and block, per stack, to the effect's owner
+enum class EffectTrigger
+{
+	DAMAGE_DEALT,
+	DAMAGE_RECEIVED,
+	BLOCK_GAINED,
+	DEBUFF_RECEIVED,
+	TURN_START,
+	CARD_PLAYED,
+	COUNT
 };
 
 
@@ -27,26 +43,30 @@ public:
 	//constructor
 	explicit EffectDefinition(XmlElement const& element);
 
+	//accessors
+	bool HasTrigger(EffectTrigger trigger) const;
+
 	//static functions
 	static void InitializeEffectDefs();
 	static EffectDefinition const* GetEffectDefinition(std::string name);
+	static EffectTrigger GetTriggerFromName(std::string const& triggerName);	//EffectTrigger::COUNT if the name isn't recognized
 
 //public member variables
 public:
 	//effect parameters
 	std::string m_name = "null effect";
 	Texture* m_sprite = nullptr;
+	AABB2	 m_spriteUVs = AABB2(0.0f, 0.0f, 1.0f, 1.0f);
 	EffectType m_type = EffectType::INVALID;
 	StackType m_stackType = StackType::NONE;
 
-	bool m_modDealtDamage = false;
-	bool m_modReceivedDamage = false;
-	bool m_modBlock = false;
+	unsigned int m_triggerFlags = 0;	//one bit per EffectTrigger
 
 	bool m_usePercentage = false;
 	float m_percentModifier = 1.0f;
 
-	bool m_blockDebuff = false;
+	int m_triggerDamage = 0;
+	int m_triggerBlock = 0;
 	
 	//static variables
 	static std::vector<EffectDefinition> s_effectDefs;
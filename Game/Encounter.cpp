@@ -9,6 +9,10 @@
 #include "Game/CardDefinition.hpp"
 #include "Game/Card.hpp"
 #include "Game/SaveManager.hpp"
+#include "Game/StatusTickEngine.hpp"
+#include "Game/RunTelemetry.hpp"
+#include "Game/AllocationTracker.hpp"
+#include "Game/FrameAllocator.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Renderer/Renderer.hpp"
@@ -25,6 +29,8 @@ Encounter::Encounter(EncounterDefinition const* definition, int encounterNumber,
 	, m_player(player)
 	, m_map(map)
 {
+	m_encounterNumberLabel.SetValues(m_encounterNumber + 1);
+
 	for (int defIndex = 0; defIndex < m_definition->m_enemies.size(); defIndex++)
 	{
 		m_currentEnemies.emplace_back(new Enemy(m_definition->m_enemies[defIndex], this, m_definition->m_enemyBounds[defIndex]));
@@ -63,15 +69,15 @@ Encounter::~Encounter()
 }
 
 
+#if !defined(GAME_HEADLESS)
 //
 //public game flow functions
 //
-void Encounter::Update()
+void Encounter::Update(float deltaSeconds)
 {
+	//card reward clicks are dispatched by Game's hit-test index
 	if (m_cardRewardScreenOpen)
 	{
-		UpdateCardRewardScreen();
-
 		return;
 	}
 
@@ -79,47 +85,24 @@ void Encounter::Update()
 	{
 		if (m_currentEnemies[enemyIndex]->m_currentHealth > 0)
 		{
-			m_currentEnemies[enemyIndex]->Update();
+			m_currentEnemies[enemyIndex]->Update(deltaSeconds);
 		}
 	}
 	
-	std::string encounterNumberText = Stringf("Encounter %i", m_encounterNumber + 1);
-	DebugAddScreenText(encounterNumberText, Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_SIZE_Y - 5.0f), 20.0f, Vec2(0.5f, 1.0f), 0.0f);
-	
-	if (m_turnState == TurnState::PLAYER)
+	//the enemy turn has already been resolved, but it still reads as the enemy's turn until its timeline has played out
+	bool isEnemyTurnShowing = m_turnState == TurnState::ENEMY || g_theGame->m_combatTimeline.IsPlayingBeats();
+	if (!isEnemyTurnShowing)
 	{
-		std::string turnNumberText = Stringf("Turn %i: Player's Turn", m_turnNumber);
-		DebugAddScreenText(turnNumberText, Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_SIZE_Y - 30.0f), 30.0f, Vec2(0.5f, 1.0f), 0.0f);
+		m_turnLabel.SetFormat("Turn %i: Player's Turn");
+		m_turnLabel.SetColor(Rgba8());
+		m_turnLabel.SetValues(m_turnNumber);
 	}
-	else if (m_turnState == TurnState::ENEMY)
+	else
 	{
-		std::string turnNumberText = Stringf("Turn %i: Enemy's Turn", m_turnNumber);
-		DebugAddScreenText(turnNumberText, Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_SIZE_Y - 30.0f), 30.0f, Vec2(0.5f, 1.0f), 0.0f, Rgba8(255, 100, 100), Rgba8(255, 100, 100));
-
-		m_enemyTurnTimer -= g_theGame->m_gameClock.GetDeltaSeconds();
-		if (m_enemyTurnTimer <= 0.0f)
-		{
-			m_enemyTurnTimer = ENEMY_TURN_DURATION;
-			
-			if (m_nextEnemyToAct >= m_currentEnemies.size())
-			{
-				ChangeTurnState(TurnState::PLAYER);
-				m_nextEnemyToAct = 0;
-			}
-			else
-			{
-				while (m_currentEnemies[m_nextEnemyToAct]->m_currentHealth == 0)
-				{
-					m_nextEnemyToAct++;	//skip over dead enemies
-					if (m_nextEnemyToAct >= m_currentEnemies.size()) break;
-				}
-				if (m_nextEnemyToAct < m_currentEnemies.size())
-				{
-					m_currentEnemies[m_nextEnemyToAct]->PerformCurrentIntention();
-				}
-				m_nextEnemyToAct++;
-			}
-		}
+		int enemyTurnNumber = (m_turnState == TurnState::ENEMY) ? m_turnNumber : m_turnNumber - 1;
+		m_turnLabel.SetFormat("Turn %i: Enemy's Turn");
+		m_turnLabel.SetColor(Rgba8(255, 100, 100));
+		m_turnLabel.SetValues(enemyTurnNumber);
 	}
 }
 
@@ -133,43 +116,12 @@ void Encounter::Render() const
 		return;
 	}
 
-	//render background
-	std::vector<Vertex_PCU> backgroundVerts;
-	AABB2 screenBounds = AABB2(0.0f, 0.0f, SCREEN_CAMERA_SIZE_X, SCREEN_CAMERA_SIZE_Y);
-
-	Rgba8 backgroundColor1 = Rgba8(30, 65, 100);
-	Rgba8 backgroundColor2 = Rgba8(60, 120, 100);
-	if (m_definition->m_difficultyLevel == 1)
+	//render background; the gradient only depends on the difficulty, so it's only rebuilt if a reload changes that
+	if (m_backgroundLayer.IsDirty() || m_backgroundLayerDifficulty != m_definition->m_difficultyLevel)
 	{
-		backgroundColor1 = Rgba8(100, 15, 90);
-		backgroundColor2 = Rgba8(30, 120, 5);
+		RebuildBackgroundLayer();
 	}
-	else if(m_definition->m_difficultyLevel == 2)
-	{
-		backgroundColor1 = Rgba8(190, 75, 0);
-		backgroundColor2 = Rgba8(100, 50, 0);
-	}
-	else if (m_definition->m_difficultyLevel == 3)
-	{
-		backgroundColor1 = Rgba8(95, 165, 5);
-		backgroundColor2 = Rgba8(25, 75, 35);
-	}
-	else if (m_definition->m_difficultyLevel == 4)
-	{
-		backgroundColor1 = Rgba8(165, 0, 190);
-		backgroundColor2 = Rgba8(100, 0, 75);
-	}
-
-	backgroundVerts.push_back(Vertex_PCU(screenBounds.m_mins, backgroundColor1));
-	backgroundVerts.push_back(Vertex_PCU(Vec2(screenBounds.m_maxs.x, screenBounds.m_mins.y), backgroundColor1));
-	backgroundVerts.push_back(Vertex_PCU(screenBounds.m_maxs, backgroundColor2));
-
-	backgroundVerts.push_back(Vertex_PCU(screenBounds.m_mins, backgroundColor1));
-	backgroundVerts.push_back(Vertex_PCU(screenBounds.m_maxs, backgroundColor2));
-	backgroundVerts.push_back(Vertex_PCU(Vec2(screenBounds.m_mins.x, screenBounds.m_maxs.y), backgroundColor2));
-
-	g_theRenderer->BindTexture(nullptr);
-	g_theRenderer->DrawVertexArray(backgroundVerts);
+	m_backgroundLayer.Render();
 	
 	//render player
 	m_player->Render();
@@ -183,6 +135,9 @@ void Encounter::Render() const
 		}
 	}
 
+	m_encounterNumberLabel.Render();
+	m_turnLabel.Render();
+
 	////render turn indicator
 	//std::vector<Vertex_PCU> indicatorVerts;
 	//if (m_turnState == TurnState::PLAYER)
@@ -207,27 +162,43 @@ void Encounter::Render() const
 }
 
 
-void Encounter::UpdateCardRewardScreen()
+void Encounter::RebuildBackgroundLayer() const
 {
-	bool card0Chosen = false;
-	bool card1Chosen = false;
-	bool card2Chosen = false;
-	m_cardRewards[0].Update(0, card0Chosen, true);
-	m_cardRewards[1].Update(1, card1Chosen, true);
-	m_cardRewards[2].Update(2, card2Chosen, true);
-
-	if (card0Chosen)
+	m_backgroundLayerDifficulty = m_definition->m_difficultyLevel;
+	std::vector<Vertex_PCU>& backgroundVerts = m_backgroundLayer.BeginRebuild(nullptr);
+
+	AABB2 screenBounds = AABB2(0.0f, 0.0f, SCREEN_CAMERA_SIZE_X, SCREEN_CAMERA_SIZE_Y);
+
+	Rgba8 backgroundColor1 = Rgba8(30, 65, 100);
+	Rgba8 backgroundColor2 = Rgba8(60, 120, 100);
+	if (m_definition->m_difficultyLevel == 1)
 	{
-		AcceptCardReward(0);
+		backgroundColor1 = Rgba8(100, 15, 90);
+		backgroundColor2 = Rgba8(30, 120, 5);
+	}
+	else if(m_definition->m_difficultyLevel == 2)
+	{
+		backgroundColor1 = Rgba8(190, 75, 0);
+		backgroundColor2 = Rgba8(100, 50, 0);
 	}
-	else if (card1Chosen)
+	else if (m_definition->m_difficultyLevel == 3)
 	{
-		AcceptCardReward(1);
+		backgroundColor1 = Rgba8(95, 165, 5);
+		backgroundColor2 = Rgba8(25, 75, 35);
 	}
-	else if (card2Chosen)
+	else if (m_definition->m_difficultyLevel == 4)
 	{
-		AcceptCardReward(2);
+		backgroundColor1 = Rgba8(165, 0, 190);
+		backgroundColor2 = Rgba8(100, 0, 75);
 	}
+
+	backgroundVerts.push_back(Vertex_PCU(screenBounds.m_mins, backgroundColor1));
+	backgroundVerts.push_back(Vertex_PCU(Vec2(screenBounds.m_maxs.x, screenBounds.m_mins.y), backgroundColor1));
+	backgroundVerts.push_back(Vertex_PCU(screenBounds.m_maxs, backgroundColor2));
+
+	backgroundVerts.push_back(Vertex_PCU(screenBounds.m_mins, backgroundColor1));
+	backgroundVerts.push_back(Vertex_PCU(screenBounds.m_maxs, backgroundColor2));
+	backgroundVerts.push_back(Vertex_PCU(Vec2(screenBounds.m_mins.x, screenBounds.m_maxs.y), backgroundColor2));
 }
 
 
@@ -237,17 +208,20 @@ void Encounter::RenderCardRewardScreen() const
 	DebugAddScreenText("Reward! Pick One:", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_SIZE_Y - 25.0f), 50.0f, Vec2(0.5f, 1.0f), 0.0f);
 
 	//draw background panel
-	std::vector<Vertex_PCU> panelVerts;
+	FrameVerts panelVerts;
+	panelVerts.reserve(6);
 	AABB2 panel = AABB2(150.0f, 75.0f, SCREEN_CAMERA_SIZE_X - 150.0f, SCREEN_CAMERA_SIZE_Y - 75.0f);
 	AddVertsForAABB2(panelVerts, panel, Rgba8(50, 50, 50));
 	g_theRenderer->BindTexture(nullptr);
-	g_theRenderer->DrawVertexArray(panelVerts);
+	DrawFrameVerts(panelVerts);
 
 	//draw each card
-	m_cardRewards[0].Render(0, true);
-	m_cardRewards[1].Render(1, true);
-	m_cardRewards[2].Render(2, true);
+	for (int rewardIndex = 0; rewardIndex < NUM_CARD_REWARDS; rewardIndex++)
+	{
+		m_cardRewards[rewardIndex].Render(CardLayout::GetRewardSlotBounds(rewardIndex, NUM_CARD_REWARDS));
+	}
 }
+#endif
 
 
 //
@@ -290,26 +264,68 @@ void Encounter::ChangeTurnState(TurnState turnState)
 }
 
 
+void Encounter::ResolveEnemyTurn()
+{
+	ScopedAllocationTag allocationTag(AllocationTag::COMBAT);
+
+	//every enemy acts in this one call; the pacing the player sees comes from the combat timeline instead
+	ChangeTurnState(TurnState::ENEMY);
+
+	for (int enemyIndex = 0; enemyIndex < m_currentEnemies.size(); enemyIndex++)
+	{
+		Enemy* enemy = m_currentEnemies[enemyIndex];
+		if (enemy == nullptr || enemy->m_currentHealth == 0)
+		{
+			continue;
+		}
+
+		CombatEvent actedEvent;
+		actedEvent.m_type = CombatEventType::ENEMY_ACTED;
+		actedEvent.m_enemy = enemy;
+		actedEvent.m_seconds = ENEMY_TURN_DURATION;
+		g_theGame->m_combatEvents.Push(actedEvent);
+
+		enemy->PerformCurrentIntention();
+
+		//stay in the enemy's turn if the player died, the game over screen takes it from there
+		if (m_player->m_currentHealth == 0)
+		{
+			return;
+		}
+	}
+
+	CombatEvent pauseEvent;
+	pauseEvent.m_type = CombatEventType::TURN_PAUSE;
+	pauseEvent.m_seconds = ENEMY_TURN_DURATION;
+	g_theGame->m_combatEvents.Push(pauseEvent);
+
+	ChangeTurnState(TurnState::PLAYER);
+}
+
+
 void Encounter::BeginPlayerTurn()
 {
 	//increment turn counter at beginning of player's turn
 	m_turnNumber++;
+	g_runTelemetry.RecordEncounterTurn(m_encounterNumber, m_turnNumber);
 
 	//get rid of any previously selected cards, just in case
 	m_player->m_selectedCard = nullptr;
 
-	//player draws five cards
-	m_player->DrawCard();
-	m_player->DrawCard();
-	m_player->DrawCard();
-	m_player->DrawCard();
-	m_player->DrawCard();
+	//player draws their cards for the turn
+	for (int drawIndex = 0; drawIndex < CARDS_DRAWN_PER_TURN; drawIndex++)
+	{
+		m_player->DrawCard();
+	}
 
 	//restore energy to max
 	m_player->ReturnToStartEnergy();
 
 	//lose block from previous turn
 	m_player->m_currentBlock = 0;
+
+	//start of turn effects go after the block reset so any block they grant lasts the turn
+	m_player->ApplyTriggeredEffects(EffectTrigger::TURN_START);
 }
 
 
@@ -321,12 +337,17 @@ void Encounter::EndPlayerTurn()
 
 void Encounter::BeginEnemyTurn()
 {
-	//lose block from previous turn
+	//lose block from previous turn, then run start of turn effects on anyone still standing
 	for (int defIndex = 0; defIndex < m_currentEnemies.size(); defIndex++)
 	{
 		if (m_currentEnemies[defIndex] != nullptr)
 		{
 			m_currentEnemies[defIndex]->m_currentBlock = 0;
+
+			if (m_currentEnemies[defIndex]->m_currentHealth > 0)
+			{
+				m_currentEnemies[defIndex]->ApplyTriggeredEffects(EffectTrigger::TURN_START);
+			}
 		}
 	}
 }
@@ -345,72 +366,8 @@ void Encounter::EndEnemyTurn()
 		}
 	}
 
-	//reduce enemy effects of duration stack type by one
-	for (int enemyIndex = 0; enemyIndex < m_currentEnemies.size(); enemyIndex++)
-	{
-		Enemy* enemy = m_currentEnemies[enemyIndex];
-
-		for (int effectIndex = 0; effectIndex < enemy->m_effects.size(); effectIndex++)
-		{
-			Effect& effect = enemy->m_effects[effectIndex];
-
-			if (effect.m_justAdded)
-			{
-				effect.m_justAdded = false;
-			}
-
-			if (effect.m_definition->m_stackType == StackType::DURATION)
-			{
-				effect.m_stack -= 1;
-				
-				if (effect.m_stack <= 0)
-				{
-					//use erase-remove idiom to remove effect
-					enemy->m_effects.erase(std::remove_if(
-						enemy->m_effects.begin(),
-						enemy->m_effects.end(),
-						[=](auto const& element)
-						{
-							return element == effect;
-						}),
-						enemy->m_effects.end()
-					);
-				}
-			}
-		}
-	}
-
-	//reduce player effects of duration stack type by one (unless they were just inflicted that turn)
-	for (int effectIndex = 0; effectIndex < m_player->m_effects.size(); effectIndex++)
-	{
-		Effect& effect = m_player->m_effects[effectIndex];
-
-		if (effect.m_justAdded)
-		{
-			effect.m_justAdded = false;
-		}
-		else
-		{
-			if (effect.m_definition->m_stackType == StackType::DURATION)
-			{
-				effect.m_stack -= 1;
-
-				if (effect.m_stack <= 0)
-				{
-					//use erase-remove idiom to remove effect
-					m_player->m_effects.erase(std::remove_if(
-						m_player->m_effects.begin(),
-						m_player->m_effects.end(),
-						[=](auto const& element)
-						{
-							return effect == element;
-						}),
-						m_player->m_effects.end()
-					);
-				}
-			}
-		}
-	}
+	//tick status effects on everyone
+	StatusTickEngine::TickEndOfEnemyTurn(m_player, m_currentEnemies);
 }
 
 
@@ -418,6 +375,7 @@ void Encounter::EndEncounter()
 {
 	m_player->ResetCards();
 	m_player->m_effects.clear();
+	m_player->m_effectTriggers.Clear();
 }
 
 
@@ -443,6 +401,22 @@ bool Encounter::AreAllEnemiesDead() const
 }
 
 
+//dead enemies aren't updated or drawn, so only the living ones can still be fading back from a hit
+bool Encounter::IsAnyEnemyFlashing() const
+{
+	for (int enemyIndex = 0; enemyIndex < m_currentEnemies.size(); enemyIndex++)
+	{
+		Enemy const* enemy = m_currentEnemies[enemyIndex];
+		if (enemy != nullptr && enemy->m_currentHealth > 0 && enemy->IsFlashing())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
 void Encounter::KillAllEnemies()
 {
 	for (int enemyIndex = 0; enemyIndex < m_currentEnemies.size(); enemyIndex++)
@@ -473,5 +447,6 @@ void Encounter::AcceptCardReward(int cardRewardNum)
 	}
 	
 	m_player->m_deck.emplace_back(m_cardRewards[cardRewardNum]);
+	g_runTelemetry.RecordRewardPicked();
 	m_map->EnterNextEncounter();
 }
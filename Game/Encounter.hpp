@@ -1,5 +1,7 @@
 #pragma once
 #include "Game/Card.hpp"
+#include "Game/HudLabel.hpp"
+#include "Game/SceneLayer.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
 
@@ -11,7 +13,8 @@ class Map;
 
 
 //constants
-constexpr float ENEMY_TURN_DURATION = 2.0f;
+constexpr float ENEMY_TURN_DURATION = 2.0f;	//presentation time per acting enemy, at a playback rate of 1
+constexpr int NUM_CARD_REWARDS = 3;
 
 
 //turn state machine
@@ -31,14 +34,15 @@ public:
 	~Encounter();
 
 	//game flow functions
-	void Update();
+	void Update(float deltaSeconds);
 	void Render() const;
-	void UpdateCardRewardScreen();
 	void RenderCardRewardScreen() const;
+	void RebuildBackgroundLayer() const;
 
 	//turn utilities
 	void BeginEncounter();
 	void ChangeTurnState(TurnState turnState);
+	void ResolveEnemyTurn();
 	void BeginPlayerTurn();
 	void EndPlayerTurn();
 	void BeginEnemyTurn();
@@ -47,6 +51,7 @@ public:
 
 	//enemy utilities
 	bool AreAllEnemiesDead() const;
+	bool IsAnyEnemyFlashing() const;
 	void KillAllEnemies();
 
 	//card reward screen functions
@@ -57,15 +62,21 @@ public:
 public:
 	int		  m_encounterNumber = 0;
 	int		  m_turnNumber = 0;
-	int		  m_nextEnemyToAct = 0;
 	TurnState m_turnState = TurnState::PLAYER;
 	std::vector<Enemy*> m_currentEnemies;
-	float m_enemyTurnTimer = ENEMY_TURN_DURATION;
 
 	bool m_cardRewardScreenOpen = false;
-	Card m_cardRewards[3];
+	Card m_cardRewards[NUM_CARD_REWARDS];
 	
 	EncounterDefinition const* m_definition = nullptr;
 	Map* m_map = nullptr;
 	Player* m_player = nullptr;
+
+	//hud labels
+	HudLabel m_encounterNumberLabel = HudLabel("Encounter %i", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_SIZE_Y - 5.0f), 20.0f, Vec2(0.5f, 1.0f));
+	HudLabel m_turnLabel = HudLabel("Turn %i: Player's Turn", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_SIZE_Y - 30.0f), 30.0f, Vec2(0.5f, 1.0f));
+
+	//retained scene layers
+	mutable SceneLayer m_backgroundLayer;
+	mutable int		   m_backgroundLayerDifficulty = -1;	//difficulty the background gradient was built for
 };
@@ -1,9 +1,11 @@
 #include "Game/EncounterDefinition.hpp"
 #include "Game/EnemyDefinition.hpp"
+#include "Engine/Core/StringUtils.hpp"
 
 
 //static variable declaration
 std::vector<EncounterDefinition> EncounterDefinition::s_encounterDefs;
+uint32_t EncounterDefinition::s_registryGeneration = 0;
 
 
 //
@@ -47,16 +49,18 @@ void EncounterDefinition::InitializeEncounterDefs()
 	XmlElement* rootElement = encounterDefsXml.RootElement();
 	GUARANTEE_OR_DIE(rootElement != nullptr, "Failed to read encounter definitions root element!");
 
+	s_registryGeneration++;
+
 	XmlElement* encounterDefElement = rootElement->FirstChildElement();
-	uint8_t currentEncounterID = 0;
+	uint32_t currentEncounterIndex = 0;
 	while (encounterDefElement != nullptr)
 	{
 		std::string elementName = encounterDefElement->Name();
 		GUARANTEE_OR_DIE(elementName == "EncounterDefinition", "Child element names in encounter definitions xml file must be <EncounterDefinition>!");
 		EncounterDefinition newEncounterDef = EncounterDefinition(*encounterDefElement);
-		newEncounterDef.m_id = currentEncounterID;
+		newEncounterDef.m_handle = EncounterDefHandle(currentEncounterIndex, s_registryGeneration);
 		s_encounterDefs.emplace_back(newEncounterDef);
-		currentEncounterID++;
+		currentEncounterIndex++;
 		encounterDefElement = encounterDefElement->NextSiblingElement();
 	}
 }
@@ -72,3 +76,59 @@ EncounterDefinition const* EncounterDefinition::GetEncounterDefinition(int encou
 	//return null if it wasn't found
 	return nullptr;
 }
+
+
+EncounterDefinition const* EncounterDefinition::GetEncounterDefinition(EncounterDefHandle handle)
+{
+	if (!handle.IsValid() || handle.GetIndex() >= s_encounterDefs.size())
+	{
+		return nullptr;
+	}
+
+	handle.CheckGeneration(s_registryGeneration);
+	return &s_encounterDefs[handle.GetIndex()];
+}
+
+
+EncounterDefHandle EncounterDefinition::GetEncounterDefHandle(uint32_t index)
+{
+	if (index >= s_encounterDefs.size())
+	{
+		return EncounterDefHandle();
+	}
+
+	return EncounterDefHandle(index, s_registryGeneration);
+}
+
+
+bool EncounterDefinition::IsValidXml(XmlElement const& element, std::string& out_problem)
+{
+	XmlElement const* enemiesRootElement = element.FirstChildElement();
+	if (enemiesRootElement == nullptr)
+	{
+		out_problem = "Encounter has no enemies element";
+		return false;
+	}
+
+	XmlElement const* enemyElement = enemiesRootElement->FirstChildElement();
+	while (enemyElement != nullptr)
+	{
+		std::string elementName = enemyElement->Name();
+		if (elementName != "Enemy")
+		{
+			out_problem = Stringf("Encounter has a <%s> where an <Enemy> belongs", elementName.c_str());
+			return false;
+		}
+
+		std::string enemyName = ParseXmlAttribute(*enemyElement, "name", "invalid enemy name");
+		if (EnemyDefinition::GetEnemyDefinition(enemyName) == nullptr)
+		{
+			out_problem = Stringf("Encounter uses unknown enemy \"%s\"", enemyName.c_str());
+			return false;
+		}
+
+		enemyElement = enemyElement->NextSiblingElement();
+	}
+
+	return true;
+}
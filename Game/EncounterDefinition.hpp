@@ -1,9 +1,15 @@
 #pragma once
+#include "Game/DefinitionHandle.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
 
 //forward declarations
 class EnemyDefinition;
+class EncounterDefinition;
+
+
+//typedefs
+typedef DefinitionHandle<EncounterDefinition> EncounterDefHandle;
 
 
 class EncounterDefinition
@@ -16,15 +22,19 @@ public:
 	//static functions
 	static void InitializeEncounterDefs();
 	static EncounterDefinition const* GetEncounterDefinition(int encounterID);
+	static EncounterDefinition const* GetEncounterDefinition(EncounterDefHandle handle);
+	static EncounterDefHandle GetEncounterDefHandle(uint32_t index);	//invalid handle if the index is out of range
+	static bool IsValidXml(XmlElement const& element, std::string& out_problem);	//also rejects enemies that aren't loaded
 
 //public member variables
 public:
 	//encounter parameters
-	uint8_t m_id = 0;
+	EncounterDefHandle m_handle;
 	int m_difficultyLevel = 0;
 	std::vector<EnemyDefinition const*> m_enemies;
 	std::vector<AABB2> m_enemyBounds;
 
 	//static variables
 	static std::vector<EncounterDefinition> s_encounterDefs;
+	static uint32_t s_registryGeneration;	//bumped each time s_encounterDefs is rebuilt, handles from older generations are stale
 };
@@ -1,5 +1,6 @@
 #include "Game/Enemy.hpp"
 #include "Game/Game.hpp"
+#include "Game/SpriteAtlas.hpp"
 #include "Game/App.hpp"
 #include "Game/Player.hpp"
 #include "Game/Encounter.hpp"
@@ -7,6 +8,8 @@
 #include "Game/CardDefinition.hpp"
 #include "Game/EffectDefinition.hpp"
 #include "Game/Card.hpp"
+#include "Game/RunTelemetry.hpp"
+#include "Game/FrameAllocator.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
@@ -24,22 +27,31 @@ Enemy::Enemy(EnemyDefinition const* definition, Encounter* encounter, AABB2 rend
 	, m_renderBounds(renderBounds)
 {
 	m_currentHealth = m_definition->m_maxHealth;
+
+	float boundsMidX = (m_renderBounds.m_mins.x + m_renderBounds.m_maxs.x) * 0.5f;
+	m_healthLabel = HudLabel("HP: %i/%i", Vec2(boundsMidX, m_renderBounds.m_mins.y), 25.0f, Vec2(0.5f, 1.0f), Rgba8(255, 0, 0));
+	m_healthLabel.BindSources(&m_currentHealth, &m_definition->m_maxHealth);
+	m_blockLabel = HudLabel("Block: %i", Vec2(boundsMidX, m_renderBounds.m_mins.y - 25.0f), 25.0f, Vec2(0.5f, 1.0f), Rgba8(0, 100, 255));
+	m_blockLabel.BindSources(&m_currentBlock);
+	m_intentionLabel = HudLabel("Next:\n%i damage,\n%i block", Vec2(boundsMidX, m_renderBounds.m_maxs.y + 25.0f), 25.0f, Vec2(0.5f, 0.0f));
+	m_intentionStatusLabel = HudLabel("", Vec2(boundsMidX, m_renderBounds.m_maxs.y), 20.0f, Vec2(0.5f, 0.0f));
 }
 
 
+#if !defined(GAME_HEADLESS)
 //
 //public game flow functions
 //
-void Enemy::Update()
+void Enemy::Update(float deltaSeconds)
 {
 	//lerp back from flashing red when hit
 	if (m_renderColor.g < 255)
 	{
-		m_renderColor.g = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.g) + 360.0f * g_theGame->m_gameClock.GetDeltaSeconds(), 0.0f, 255.0f));
+		m_renderColor.g = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.g) + 360.0f * deltaSeconds, 0.0f, 255.0f));
 	}
 	if (m_renderColor.b < 255)
 	{
-		m_renderColor.b = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.b) + 360.0f * g_theGame->m_gameClock.GetDeltaSeconds(), 0.0f, 255.0f));
+		m_renderColor.b = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.b) + 360.0f * deltaSeconds, 0.0f, 255.0f));
 	}
 }
 
@@ -47,11 +59,15 @@ void Enemy::Update()
 void Enemy::Render() const
 {
 	//draw enemy sprite
-	std::vector<Vertex_PCU> enemyVerts;
-	AddVertsForAABB2(enemyVerts, m_renderBounds, m_renderColor);
-
-	g_theRenderer->BindTexture(m_definition->m_sprite);
-	g_theRenderer->DrawVertexArray(enemyVerts);
+	//an idle enemy's sprite is redrawn as built; it's only rebuilt while it flashes from a hit or after its definition reloads
+	if (m_spriteLayer.IsDirty() || !(m_spriteLayerColor == m_renderColor) || m_spriteLayerRevision != m_definition->m_revision)
+	{
+		m_spriteLayerColor = m_renderColor;
+		m_spriteLayerRevision = m_definition->m_revision;
+		std::vector<Vertex_PCU>& enemyVerts = m_spriteLayer.BeginRebuild(m_definition->m_sprite);
+		AddVertsForAABB2(enemyVerts, m_renderBounds, m_renderColor, m_definition->m_spriteUVs);
+	}
+	m_spriteLayer.Render();
 
 	//draw overlay if selected as card target
 	Vec2 mousePosition = g_theInput->GetCursorNormalizedPosition();
@@ -60,148 +76,84 @@ void Enemy::Render() const
 	Card* selectedCard = g_theGame->m_player->m_selectedCard;
 	if (selectedCard != nullptr && selectedCard->m_definition->m_targetMode == TargetMode::ONE && IsPointInsideAABB2D(gameMousePosition, m_renderBounds))
 	{
-		std::vector<Vertex_PCU> overlayVerts;
+		FrameVerts overlayVerts;
+		overlayVerts.reserve(6);
 		AddVertsForAABB2(overlayVerts, m_renderBounds, Rgba8(255, 255, 255, 75));
 		g_theRenderer->BindTexture(nullptr);
-		g_theRenderer->DrawVertexArray(overlayVerts);
+		DrawFrameVerts(overlayVerts);
 	}
 
-	float boundsMidX = (m_renderBounds.m_mins.x + m_renderBounds.m_maxs.x) * 0.5f;
-
 	//display health and block
-	std::string healthText = Stringf("HP: %i/%i", m_currentHealth, m_definition->m_maxHealth);
-	DebugAddScreenText(healthText, Vec2(boundsMidX, m_renderBounds.m_mins.y), 25.0f, Vec2(0.5f, 1.0f), 0.0f, Rgba8(255, 0, 0), Rgba8(255, 0, 0));
-	std::string blockText = Stringf("Block: %i", m_currentBlock);
-	DebugAddScreenText(blockText, Vec2(boundsMidX, m_renderBounds.m_mins.y - 25.0f), 25.0f, Vec2(0.5f, 1.0f), 0.0f, Rgba8(0, 100, 255), Rgba8(0, 100, 255));
+	m_healthLabel.Render();
+	m_blockLabel.Render();
 
-	int finalDamage = m_currentIntention->m_damage;
-	if (finalDamage != 0)
-	{
-		for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
-		{
-			Effect const& effect = m_effects[effectIndex];
+	Intention const& currentIntention = GetCurrentIntention();
 
-			if (effect.m_definition->m_modDealtDamage)
-			{
-				if (effect.m_definition->m_usePercentage)
-				{
-					finalDamage = static_cast<int>(static_cast<float>(finalDamage) * effect.m_definition->m_percentModifier);
-				}
-				else
-				{
-					finalDamage += effect.m_stack;
-				}
-			}
-		}
-
-		for (int effectIndex = 0; effectIndex < g_theGame->m_player->m_effects.size(); effectIndex++)
-		{
-			Effect const& effect = g_theGame->m_player->m_effects[effectIndex];
-
-			if (effect.m_definition->m_modReceivedDamage)
-			{
-				if (effect.m_definition->m_usePercentage)
-				{
-					finalDamage = static_cast<int>(static_cast<float>(finalDamage) * effect.m_definition->m_percentModifier);
-				}
-				else
-				{
-					finalDamage += effect.m_stack;
-				}
-			}
-		}
+	int finalDamage = currentIntention.m_damage;
+	if (currentIntention.m_numHits > 0)
+	{
+		finalDamage = ModifyAmount(EffectTrigger::DAMAGE_DEALT, finalDamage);
+		finalDamage = g_theGame->m_player->ModifyAmount(EffectTrigger::DAMAGE_RECEIVED, finalDamage);
 	}
 
-	int finalBlock = m_currentIntention->m_block;
+	int finalBlock = currentIntention.m_block;
 	if (finalBlock != 0)
 	{
-		for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
-		{
-			Effect const& effect = m_effects[effectIndex];
-
-			if (effect.m_definition->m_modBlock)
-			{
-				if (effect.m_definition->m_usePercentage)
-				{
-					finalBlock = static_cast<int>(static_cast<float>(finalBlock) * effect.m_definition->m_percentModifier);
-				}
-				else
-				{
-					finalBlock += effect.m_stack;
-				}
-			}
-		}
+		finalBlock = ModifyAmount(EffectTrigger::BLOCK_GAINED, finalBlock);
 	}
 
 	//display intention
-	//-------------------------
-	//NOTE: Intention text currently does not support enemies being able to do more than one bonus effect per action
-	//-------------------------
-	std::string intentionText = Stringf("Next:\n%i damage,\n%i block", finalDamage, finalBlock);
-	if (m_encounter->m_turnState == TurnState::ENEMY)
+	//the hit count and bonus actions only depend on the intention itself, so they're only reformatted when the intention changes
+	if (m_labeledIntentionIndex != m_currentIntentionIndex || m_labeledRevision != m_definition->m_revision)
 	{
-		DebugAddScreenText(intentionText, Vec2(boundsMidX, m_renderBounds.m_maxs.y + 25.0f), 25.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(), Rgba8());
-		if (m_currentIntention->m_cardToAdd != nullptr)
-		{
-			std::string intentionStatusText = Stringf("Inflict: %s", m_currentIntention->m_cardToAdd->m_name.c_str());
-			DebugAddScreenText(intentionStatusText, Vec2(boundsMidX, m_renderBounds.m_maxs.y), 20.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(), Rgba8());
-		}
-		else if (m_currentIntention->m_inflictEffect != nullptr)
-		{
-			std::string inflictEffectText = Stringf("Inflict: %i %s", m_currentIntention->m_inflictEffectStack, m_currentIntention->m_inflictEffect->m_name.c_str());
-			DebugAddScreenText(inflictEffectText, Vec2(boundsMidX, m_renderBounds.m_maxs.y), 20.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(), Rgba8());
-		}
-		else if (m_currentIntention->m_gainEffect != nullptr)
+		m_labeledIntentionIndex = m_currentIntentionIndex;
+		m_labeledRevision = m_definition->m_revision;
+
+		if (currentIntention.m_numHits > 1)
 		{
-			std::string gainEffectText = Stringf("Gain: %i %s", m_currentIntention->m_gainEffectStack, m_currentIntention->m_gainEffect->m_name.c_str());
-			DebugAddScreenText(gainEffectText, Vec2(boundsMidX, m_renderBounds.m_maxs.y), 20.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(), Rgba8());
+			m_intentionLabel.SetFormat(Stringf("Next:\n%%i x%i damage,\n%%i block", currentIntention.m_numHits).c_str());
 		}
-		else if (m_currentIntention->m_preparing)
+		else
 		{
-			DebugAddScreenText("Preparing...", Vec2(boundsMidX, m_renderBounds.m_maxs.y), 20.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(), Rgba8());
+			m_intentionLabel.SetFormat("Next:\n%i damage,\n%i block");
 		}
+		m_intentionStatusLabel.SetText(currentIntention.m_statusText);
 	}
-	else
+
+	Rgba8 intentionColor = (m_encounter->m_turnState == TurnState::ENEMY) ? Rgba8() : Rgba8(255, 100, 100);
+	m_intentionLabel.SetValues(finalDamage, finalBlock);
+	m_intentionLabel.SetColor(intentionColor);
+	m_intentionLabel.Render();
+	m_intentionStatusLabel.SetColor(intentionColor);
+	m_intentionStatusLabel.Render();
+
+	//render effect icons
+	if (m_effectStackLabels.size() < m_effects.size())
 	{
-		DebugAddScreenText(intentionText, Vec2(boundsMidX, m_renderBounds.m_maxs.y + 25.0f), 25.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(255, 100, 100), Rgba8(255, 100, 100));
-		if (m_currentIntention->m_cardToAdd != nullptr)
-		{
-			std::string intentionStatusText = Stringf("Inflict: %s", m_currentIntention->m_cardToAdd->m_name.c_str());
-			DebugAddScreenText(intentionStatusText, Vec2(boundsMidX, m_renderBounds.m_maxs.y), 20.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(255, 100, 100), Rgba8(255, 100, 100));
-		}
-		else if (m_currentIntention->m_inflictEffect != nullptr)
-		{
-			std::string inflictEffectText = Stringf("Inflict: %i %s", m_currentIntention->m_inflictEffectStack, m_currentIntention->m_inflictEffect->m_name.c_str());
-			DebugAddScreenText(inflictEffectText, Vec2(boundsMidX, m_renderBounds.m_maxs.y), 20.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(255, 100, 100), Rgba8(255, 100, 100));
-		}
-		else if (m_currentIntention->m_gainEffect != nullptr)
-		{
-			std::string gainEffectText = Stringf("Gain: %i %s", m_currentIntention->m_gainEffectStack, m_currentIntention->m_gainEffect->m_name.c_str());
-			DebugAddScreenText(gainEffectText, Vec2(boundsMidX, m_renderBounds.m_maxs.y), 20.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(255, 100, 100), Rgba8(255, 100, 100));
-		}
-		else if (m_currentIntention->m_preparing)
-		{
-			DebugAddScreenText("Preparing...", Vec2(boundsMidX, m_renderBounds.m_maxs.y), 20.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(255, 100, 100), Rgba8(255, 100, 100));
-		}
+		m_effectStackLabels.resize(m_effects.size(), HudLabel("%i", Vec2(), 20.0f, Vec2(0.0f, 1.0f)));
 	}
 
-	//render effect icons
+	//icons share atlas pages, so they all go out in one batch per page before any of the stack counts
+	SpriteBatch iconBatch;
+	float iconMinY = m_renderBounds.m_mins.y - 90.0f;
 	for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
 	{
 		Effect const& effect = m_effects[effectIndex];
 
 		float minX = m_renderBounds.m_mins.x + static_cast<float>(40 * effectIndex);
-		float minY = m_renderBounds.m_mins.y - 90.0f;
-		AABB2 iconBounds = AABB2(minX, minY, minX + 40.0f, minY + 40.0f);
-
-		std::vector<Vertex_PCU> iconVerts;
-		AddVertsForAABB2(iconVerts, iconBounds);
+		AABB2 iconBounds = AABB2(minX, iconMinY, minX + 40.0f, iconMinY + 40.0f);
+		iconBatch.AddSprite(iconBounds, effect.m_definition->m_sprite, effect.m_definition->m_spriteUVs);
+	}
+	iconBatch.Flush();
 
-		g_theRenderer->BindTexture(effect.m_definition->m_sprite);
-		g_theRenderer->DrawVertexArray(iconVerts);
+	for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
+	{
+		float minX = m_renderBounds.m_mins.x + static_cast<float>(40 * effectIndex);
 
-		std::string effectStackText = Stringf("%i", effect.m_stack);
-		DebugAddScreenText(effectStackText, Vec2(minX + 10.0f, minY), 20.0f, Vec2(0.0f, 1.0f), 0.0f);
+		HudLabel& stackLabel = m_effectStackLabels[effectIndex];
+		stackLabel.SetPosition(Vec2(minX + 10.0f, iconMinY));
+		stackLabel.SetValues(m_effects[effectIndex].m_stack);
+		stackLabel.Render();
 	}
 
 	//debug print effects
@@ -214,100 +166,130 @@ void Enemy::Render() const
 	}*/
 }
 
-
 //
-//public enemy utilities
+//public presentation functions
 //
-void Enemy::PerformCurrentIntention()
+void Enemy::PresentCombatEvent(CombatEvent const& event)
 {
-	//calculate amount of damage to deal
-	int finalDamage = m_currentIntention->m_damage;
-	if (finalDamage != 0)
+	float boundsMidX = (m_renderBounds.m_mins.x + m_renderBounds.m_maxs.x) * 0.5f;
+
+	switch (event.m_type)
+	{
+	case CombatEventType::HIT:
 	{
-		for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
+		if (event.m_blockedAmount > 0)
 		{
-			Effect const& effect = m_effects[effectIndex];
-
-			if (effect.m_definition->m_modDealtDamage)
-			{
-				if (effect.m_definition->m_usePercentage)
-				{
-					finalDamage = static_cast<int>(static_cast<float>(finalDamage) * effect.m_definition->m_percentModifier);
-				}
-				else
-				{
-					finalDamage += effect.m_stack;
-				}
-			}
+			g_theGame->m_floatingText.Spawn(FloatingTextStyle::BLOCKED_DAMAGE, event.m_blockedAmount, Vec2(boundsMidX - 120.0f, 325.0f));
 		}
-		for (int effectIndex = 0; effectIndex < g_theGame->m_player->m_effects.size(); effectIndex++)
+		if (event.m_amount > 0)
 		{
-			Effect const& effect = g_theGame->m_player->m_effects[effectIndex];
+			g_theGame->m_floatingText.Spawn(FloatingTextStyle::DAMAGE, event.m_amount, Vec2(boundsMidX - 120.0f, 350.0f));
 
-			if (effect.m_definition->m_modReceivedDamage)
-			{
-				if (effect.m_definition->m_usePercentage)
-				{
-					finalDamage = static_cast<int>(static_cast<float>(finalDamage) * effect.m_definition->m_percentModifier);
-				}
-				else
-				{
-					finalDamage += effect.m_stack;
-				}
-			}
+			m_renderColor.g = 0;
+			m_renderColor.b = 0;
 		}
-	}
-	g_theGame->m_player->TakeDamage(finalDamage);
 
-	//calculate amount of block to gain
-	int finalBlock = m_currentIntention->m_block;
-	if (finalBlock != 0)
+		g_theGame->BeginScreenShake(static_cast<float>(event.m_amount + event.m_blockedAmount) * 0.4f);
+		break;
+	}
+	case CombatEventType::BLOCK:
 	{
-		for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
-		{
-			Effect const& effect = m_effects[effectIndex];
-
-			if (effect.m_definition->m_modBlock)
-			{
-				if (effect.m_definition->m_usePercentage)
-				{
-					finalBlock = static_cast<int>(static_cast<float>(finalBlock) * effect.m_definition->m_percentModifier);
-				}
-				else
-				{
-					finalBlock += effect.m_stack;
-				}
-			}
-		}
+		g_theGame->m_floatingText.Spawn(FloatingTextStyle::BLOCK, event.m_amount, Vec2(boundsMidX - 120.0f, 325.0f));
+		g_theAudio->StartSound(g_blockSound);
+		break;
 	}
-	GainBlock(finalBlock);
-
-	if (m_currentIntention->m_cardToAdd != nullptr)
+	case CombatEventType::EFFECT_APPLIED:
 	{
-		Card* addedCard = new Card(m_currentIntention->m_cardToAdd, g_theGame->m_player);
-		if (g_theGame->m_player->m_drawPile.size() == 0)
+		if (event.m_effect->m_type == EffectType::DEBUFF)
 		{
-			g_theGame->m_player->m_drawPile.emplace_back(addedCard);
+			g_theAudio->StartSound(g_debuffSound);
 		}
-		else
+		else if (event.m_effect->m_type == EffectType::BUFF)
 		{
-			int randomPos = g_rng.RollRandomIntLessThan(static_cast<int>(g_theGame->m_player->m_drawPile.size()));
-			g_theGame->m_player->m_drawPile.emplace(g_theGame->m_player->m_drawPile.begin() + randomPos, addedCard);
+			g_theAudio->StartSound(g_buffSound);
 		}
-		g_theGame->m_player->m_tempAddedCards.emplace_back(addedCard);
-
-		std::string statusText = Stringf("Added %s to\ndraw pile", m_currentIntention->m_cardToAdd->m_name.c_str());
-		DebugAddScreenText(statusText, Vec2(375.0f, 700.0f), 27.5f, Vec2(0.5f, 1.0f), 2.0f, Rgba8(255, 100, 0), Rgba8(255, 100, 0));
+		break;
 	}
-
-	if (m_currentIntention->m_gainEffect != nullptr)
+	case CombatEventType::DEBUFF_BLOCKED:
 	{
-		ReceiveEffect(m_currentIntention->m_gainEffect, m_currentIntention->m_gainEffectStack);
+		g_theGame->m_floatingText.Spawn(FloatingTextStyle::ENEMY_DEBUFF_BLOCKED, 0, Vec2(m_renderBounds.GetCenter().x + 300.0f, m_renderBounds.m_maxs.y + 75.0f));
+		break;
 	}
+	default:
+		break;
+	}
+}
+#endif
 
-	if (m_currentIntention->m_inflictEffect != nullptr)
+
+//
+//public enemy utilities
+//
+void Enemy::PerformCurrentIntention()
+{
+	Player* player = g_theGame->m_player;
+	std::vector<IntentionOp> const& ops = GetCurrentIntention().m_ops;
+
+	for (int opIndex = 0; opIndex < ops.size(); opIndex++)
 	{
-		g_theGame->m_player->ReceiveEffect(m_currentIntention->m_inflictEffect, m_currentIntention->m_inflictEffectStack);
+		IntentionOp const& op = ops[opIndex];
+
+		switch (op.m_opCode)
+		{
+		case IntentionOpCode::ATTACK:
+		{
+			//modifiers are resolved once, then every hit lands for the same amount
+			int finalDamage = ModifyAmount(EffectTrigger::DAMAGE_DEALT, op.m_amount);
+			finalDamage = player->ModifyAmount(EffectTrigger::DAMAGE_RECEIVED, finalDamage);
+
+			for (int hitNum = 0; hitNum < op.m_count; hitNum++)
+			{
+				player->TakeDamage(finalDamage);
+			}
+			break;
+		}
+		case IntentionOpCode::BLOCK:
+		{
+			int blockAmount = ModifyAmount(EffectTrigger::BLOCK_GAINED, op.m_amount);
+			GainBlock(blockAmount);
+			g_runTelemetry.RecordEnemyBlock(blockAmount);
+			break;
+		}
+		case IntentionOpCode::ADD_CARD:
+		{
+			Card* addedCard = new Card(op.m_card, player);
+			if (op.m_pile == AddCardPile::DISCARD)
+			{
+				player->m_discardPile.emplace_back(addedCard);
+			}
+			else if (player->m_drawPile.size() == 0)
+			{
+				player->m_drawPile.emplace_back(addedCard);
+			}
+			else
+			{
+				int randomPos = g_rng.RollRandomIntLessThan(static_cast<int>(player->m_drawPile.size()));
+				player->m_drawPile.emplace(player->m_drawPile.begin() + randomPos, addedCard);
+			}
+			player->m_tempAddedCards.emplace_back(addedCard);
+
+			CombatEvent event;
+			event.m_type = CombatEventType::CARD_ADDED;
+			event.m_card = op.m_card;
+			g_theGame->m_combatEvents.Push(event);
+			break;
+		}
+		case IntentionOpCode::INFLICT:
+		{
+			player->ReceiveEffect(op.m_effect, op.m_count);
+			break;
+		}
+		case IntentionOpCode::GAIN:
+		{
+			ReceiveEffect(op.m_effect, op.m_count);
+			break;
+		}
+		}
 	}
 }
 
@@ -336,7 +318,15 @@ void Enemy::ChooseNextIntention()
 		}
 	}
 
-	m_currentIntention = &m_definition->m_intentions[intentionIndex];
+	m_currentIntentionIndex = intentionIndex;
+}
+
+
+Intention const& Enemy::GetCurrentIntention() const
+{
+	//a hot reload can leave the enemy with fewer intentions than it had
+	int intentionIndex = GetClamped(m_currentIntentionIndex, 0, static_cast<int>(m_definition->m_intentions.size()) - 1);
+	return m_definition->m_intentions[intentionIndex];
 }
 
 
@@ -352,23 +342,12 @@ void Enemy::TakeDamage(int damageAmount)
 	//then do damage to health
 	m_currentHealth = GetClamped(m_currentHealth - finalDamageAmount, 0, m_definition->m_maxHealth);
 
-	float boundsMidX = (m_renderBounds.m_mins.x + m_renderBounds.m_maxs.x) * 0.5f;
-
-	if (damageReduction > 0)
-	{
-		std::string blockDamageText = Stringf("-%i", damageReduction);
-		DebugAddScreenText(blockDamageText, Vec2(boundsMidX - 120.0f, 325.0f), 30.0f, Vec2(1.0f, 1.0f), 2.0f, Rgba8(0, 100, 255), Rgba8(0, 100, 255));
-	}
-	if (finalDamageAmount > 0)
-	{
-		std::string damageText = Stringf("-%i", finalDamageAmount);
-		DebugAddScreenText(damageText, Vec2(boundsMidX - 120.0f, 350.0f), 30.0f, Vec2(1.0f, 1.0f), 2.0f, Rgba8(255, 0, 0), Rgba8(255, 0, 0));
-
-		m_renderColor.g = 0;
-		m_renderColor.b = 0;
-	}
-
-	g_theGame->BeginScreenShake(static_cast<float>(damageAmount * 0.4f));
+	CombatEvent event;
+	event.m_type = CombatEventType::HIT;
+	event.m_enemy = this;
+	event.m_amount = finalDamageAmount;
+	event.m_blockedAmount = damageReduction;
+	g_theGame->m_combatEvents.Push(event);
 }
 
 
@@ -376,56 +355,53 @@ void Enemy::GainBlock(int blockAmount)
 {
 	m_currentBlock += blockAmount;
 
-	float boundsMidX = (m_renderBounds.m_mins.x + m_renderBounds.m_maxs.x) * 0.5f;
-
 	if (blockAmount > 0)
 	{
-		std::string blockText = Stringf("+%i", blockAmount);
-		DebugAddScreenText(blockText, Vec2(boundsMidX - 120.0f, 325.0f), 30.0f, Vec2(1.0f, 1.0f), 2.0f, Rgba8(0, 100, 255), Rgba8(0, 100, 255));
-		g_theAudio->StartSound(g_blockSound);
+		CombatEvent event;
+		event.m_type = CombatEventType::BLOCK;
+		event.m_enemy = this;
+		event.m_amount = blockAmount;
+		g_theGame->m_combatEvents.Push(event);
 	}
 }
 
 
 void Enemy::ReceiveEffect(EffectDefinition const* definition, int stack)
 {
-	//block debuffs with artifact
+	//block debuffs with anything that triggers on receiving one (artifact)
 	if (definition->m_type == EffectType::DEBUFF)
 	{
-		for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
+		std::vector<int> const& blockerIndices = m_effectTriggers.GetEffectIndices(EffectTrigger::DEBUFF_RECEIVED);
+		if (!blockerIndices.empty())
 		{
-			Effect& effect = m_effects[effectIndex];
+			int blockerIndex = blockerIndices[0];
+			m_effects[blockerIndex].m_stack -= 1;
+
+			CombatEvent event;
+			event.m_type = CombatEventType::DEBUFF_BLOCKED;
+			event.m_enemy = this;
+			event.m_effect = definition;
+			g_theGame->m_combatEvents.Push(event);
 
-			if (effect.m_definition->m_blockDebuff)
+			if (m_effects[blockerIndex].m_stack <= 0)
 			{
-				effect.m_stack -= 1;
-				std::string artifactMessage = "Debuff\nBlocked";
-				DebugAddScreenText(artifactMessage, Vec2(m_renderBounds.GetCenter().x + 300.0f, m_renderBounds.m_maxs.y + 75.0f), 27.5f, Vec2(0.5f, 1.0f), 2.0f, Rgba8(255, 100, 0), Rgba8(255, 100, 0));
-
-				if (effect.m_stack <= 0)
-				{
-					//use erase-remove idiom to remove effect
-					m_effects.erase(std::remove_if(
-						m_effects.begin(),
-						m_effects.end(),
-						[=](auto const& element)
-						{
-							return effect == element;
-						}),
-						m_effects.end()
-					);
-				}
-
-				return;
+				m_effects.erase(m_effects.begin() + blockerIndex);
+				m_effectTriggers.Rebuild(m_effects);
 			}
-		}
 
-		g_theAudio->StartSound(g_debuffSound);
-	}
-	else if (definition->m_type == EffectType::BUFF)
-	{
-		g_theAudio->StartSound(g_buffSound);
+			return;
+		}
 	}
+
+	//counted per target that actually takes the effect, so blocked debuffs and missed targets aren't
+	g_runTelemetry.RecordEffectApplied(definition);
+
+	CombatEvent event;
+	event.m_type = CombatEventType::EFFECT_APPLIED;
+	event.m_enemy = this;
+	event.m_amount = stack;
+	event.m_effect = definition;
+	g_theGame->m_combatEvents.Push(event);
 	
 	bool newEffect = true;
 	for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
@@ -445,5 +421,37 @@ void Enemy::ReceiveEffect(EffectDefinition const* definition, int stack)
 	if (newEffect)
 	{
 		m_effects.emplace_back(Effect(definition, stack, nullptr, this));
+		m_effectTriggers.OnEffectAdded(m_effects, static_cast<int>(m_effects.size()) - 1);
+	}
+}
+
+
+int Enemy::ModifyAmount(EffectTrigger trigger, int amount) const
+{
+	return m_effectTriggers.ApplyAmountModifiers(m_effects, trigger, amount);
+}
+
+
+void Enemy::ApplyTriggeredEffects(EffectTrigger trigger)
+{
+	int totalDamage = 0;
+	int totalBlock = 0;
+
+	std::vector<int> const& effectIndices = m_effectTriggers.GetEffectIndices(trigger);
+	for (int listIndex = 0; listIndex < effectIndices.size(); listIndex++)
+	{
+		Effect const& effect = m_effects[effectIndices[listIndex]];
+		totalDamage += effect.m_definition->m_triggerDamage * effect.m_stack;
+		totalBlock += effect.m_definition->m_triggerBlock * effect.m_stack;
+	}
+
+	//apply the totals once so a trigger shows up as a single combat number
+	if (totalBlock > 0)
+	{
+		GainBlock(totalBlock);
+	}
+	if (totalDamage > 0)
+	{
+		TakeDamage(totalDamage);
 	}
 }
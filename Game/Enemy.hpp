@@ -1,6 +1,8 @@
 #pragma once
 #include "Game/EnemyDefinition.hpp"
 #include "Game/Effect.hpp"
+#include "Game/HudLabel.hpp"
+#include "Game/SceneLayer.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/Rgba8.hpp"
 
@@ -8,6 +10,7 @@
 //forward declarations
 class Encounter;
 class EffectDefinition;
+struct CombatEvent;
 
 
 class Enemy
@@ -18,22 +21,29 @@ public:
 	explicit Enemy(EnemyDefinition const* definition, Encounter* encounter, AABB2 renderBounds);
 
 	//game flow functions
-	void Update();
+	void Update(float deltaSeconds);
 	void Render() const;
 
+	//presentation functions
+	void PresentCombatEvent(CombatEvent const& event);
+	bool IsFlashing() const { return m_renderColor.r < 255 || m_renderColor.g < 255 || m_renderColor.b < 255; }
+
 	//enemy utilities
 	void PerformCurrentIntention();
 	void ChooseNextIntention();
+	Intention const& GetCurrentIntention() const;
 	void TakeDamage(int damageAmount);
 	void GainBlock(int blockAmount);
 	void ReceiveEffect(EffectDefinition const* definition, int stack);
+	int ModifyAmount(EffectTrigger trigger, int amount) const;
+	void ApplyTriggeredEffects(EffectTrigger trigger);
 
 //public member variables
 public:
 	//enemy parameters
 	int m_currentHealth = 0;
 	int m_currentBlock = 0;
-	Intention const* m_currentIntention = nullptr;
+	int m_currentIntentionIndex = 0;	//an index rather than a pointer, so it survives the definition being hot reloaded
 
 	EnemyDefinition const* m_definition = nullptr;
 	Encounter* m_encounter = nullptr;
@@ -42,4 +52,19 @@ public:
 	Rgba8 m_renderColor = Rgba8();
 
 	std::vector<Effect> m_effects;
+	EffectTriggerLists m_effectTriggers;	//indices into m_effects, bucketed by the triggers they respond to
+
+	//hud labels
+	HudLabel m_healthLabel;
+	HudLabel m_blockLabel;
+	mutable HudLabel m_intentionLabel;
+	mutable HudLabel m_intentionStatusLabel;
+	mutable int m_labeledIntentionIndex = -1;	//intention the status label was last formatted for
+	mutable int m_labeledRevision = -1;
+	mutable std::vector<HudLabel> m_effectStackLabels;
+
+	//retained scene layers
+	mutable SceneLayer m_spriteLayer;
+	mutable Rgba8	   m_spriteLayerColor;			//hit flash color the sprite was built with
+	mutable int		   m_spriteLayerRevision = -1;	//definition revision the sprite's uvs came from
 };
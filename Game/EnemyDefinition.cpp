@@ -1,10 +1,12 @@
 #include "Game/EnemyDefinition.hpp"
+#include "Game/SpriteAtlas.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/CardDefinition.hpp"
 #include "Game/EffectDefinition.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
 
 
 //static variable declaration
@@ -18,8 +20,12 @@ EnemyDefinition::EnemyDefinition(XmlElement const& element)
 {
 	m_name = ParseXmlAttribute(element, "name", m_name);
 
+#if !defined(GAME_HEADLESS)
 	std::string textureFilePath = ParseXmlAttribute(element, "sprite", "invalid file path");
-	m_sprite = g_theRenderer->CreateOrGetTextureFromFile(textureFilePath.c_str());
+	AtlasSprite sprite = g_spriteAtlas.GetSprite(textureFilePath);
+	m_sprite = sprite.m_texture;
+	m_spriteUVs = sprite.m_uvs;
+#endif
 
 	m_maxHealth = ParseXmlAttribute(element, "maxHealth", m_maxHealth);
 	
@@ -51,22 +57,19 @@ EnemyDefinition::EnemyDefinition(XmlElement const& element)
 		GUARANTEE_OR_DIE(elementName == "Intention", "Intention elements in enemy definitions xml must be <Intention>!");
 
 		Intention intention;
-		intention.m_damage = ParseXmlAttribute(*intentionElement, "damage", 0);
-		intention.m_block = ParseXmlAttribute(*intentionElement, "block", 0);
-
-		std::string cardToAdd = ParseXmlAttribute(*intentionElement, "cardToAdd", "invalid card");
-		intention.m_cardToAdd = CardDefinition::GetCardDefinition(cardToAdd);
-
-		std::string inflictEffect = ParseXmlAttribute(*intentionElement, "inflictEffect", "invalid effect");
-		intention.m_inflictEffect = EffectDefinition::GetEffectDefinition(inflictEffect);
-		intention.m_inflictEffectStack = ParseXmlAttribute(*intentionElement, "inflictEffectStack", 0);
-
-		std::string gainEffect = ParseXmlAttribute(*intentionElement, "gainEffect", "invalid effect");
-		intention.m_gainEffect = EffectDefinition::GetEffectDefinition(gainEffect);
-		intention.m_gainEffectStack = ParseXmlAttribute(*intentionElement, "gainEffectStack", 0);
-		
 		intention.m_preparing = ParseXmlAttribute(*intentionElement, "preparing", false);
 
+		//intentions with child action elements do exactly those, in order; everything else compiles from the flat attributes
+		if (intentionElement->FirstChildElement() != nullptr)
+		{
+			CompileIntentionFromActions(*intentionElement, intention);
+		}
+		else
+		{
+			CompileIntentionFromParameters(*intentionElement, intention);
+		}
+		BuildIntentionSummary(intention);
+
 		m_intentions.emplace_back(intention);
 
 		intentionElement = intentionElement->NextSiblingElement();
@@ -112,3 +115,239 @@ EnemyDefinition const* EnemyDefinition::GetEnemyDefinition(std::string name)
 	//return null if it wasn't found
 	return nullptr;
 }
+
+
+AddCardPile EnemyDefinition::GetAddCardPileFromName(std::string const& pileName)
+{
+	if (pileName == "Draw")
+	{
+		return AddCardPile::DRAW;
+	}
+	else if (pileName == "Discard")
+	{
+		return AddCardPile::DISCARD;
+	}
+
+	return AddCardPile::INVALID;
+}
+
+
+bool EnemyDefinition::IsValidXml(XmlElement const& element, std::string& out_problem)
+{
+	std::string name = ParseXmlAttribute(element, "name", "");
+
+	XmlElement const* intentionsRootElement = element.FirstChildElement();
+	if (intentionsRootElement == nullptr)
+	{
+		out_problem = Stringf("Enemy \"%s\" has no intentions element", name.c_str());
+		return false;
+	}
+
+	XmlElement const* intentionElement = intentionsRootElement->FirstChildElement();
+	while (intentionElement != nullptr)
+	{
+		std::string elementName = intentionElement->Name();
+		if (elementName != "Intention")
+		{
+			out_problem = Stringf("Enemy \"%s\" has a <%s> where an <Intention> belongs", name.c_str(), elementName.c_str());
+			return false;
+		}
+
+		int numAttacks = 0;
+		XmlElement const* actionElement = intentionElement->FirstChildElement();
+		while (actionElement != nullptr)
+		{
+			std::string actionName = actionElement->Name();
+			if (actionName == "Attack")
+			{
+				numAttacks++;
+			}
+			else if (actionName == "AddCard")
+			{
+				std::string cardName = ParseXmlAttribute(*actionElement, "card", "invalid card");
+				if (CardDefinition::GetCardDefinition(cardName) == nullptr)
+				{
+					out_problem = Stringf("Enemy \"%s\" adds unknown card \"%s\"", name.c_str(), cardName.c_str());
+					return false;
+				}
+
+				std::string pileName = ParseXmlAttribute(*actionElement, "pile", "Draw");
+				if (GetAddCardPileFromName(pileName) == AddCardPile::INVALID)
+				{
+					out_problem = Stringf("Enemy \"%s\" adds \"%s\" to unknown pile \"%s\"", name.c_str(), cardName.c_str(), pileName.c_str());
+					return false;
+				}
+			}
+			else if (actionName == "Inflict" || actionName == "Gain")
+			{
+				std::string effectName = ParseXmlAttribute(*actionElement, "effect", "invalid effect");
+				if (EffectDefinition::GetEffectDefinition(effectName) == nullptr)
+				{
+					out_problem = Stringf("Enemy \"%s\" uses unknown effect \"%s\"", name.c_str(), effectName.c_str());
+					return false;
+				}
+			}
+
+			actionElement = actionElement->NextSiblingElement();
+		}
+
+		if (numAttacks > 1)
+		{
+			out_problem = Stringf("Enemy \"%s\" has an intention with more than one attack", name.c_str());
+			return false;
+		}
+
+		intentionElement = intentionElement->NextSiblingElement();
+	}
+
+	return true;
+}
+
+
+//
+//private intention compilation functions
+//
+void EnemyDefinition::CompileIntentionFromParameters(XmlElement const& intentionElement, Intention& intention) const
+{
+	IntentionOp op;
+
+	//same order PerformCurrentIntention has always resolved the flat attributes in
+	int damage = ParseXmlAttribute(intentionElement, "damage", 0);
+	if (damage != 0)
+	{
+		op = IntentionOp();
+		op.m_opCode = IntentionOpCode::ATTACK;
+		op.m_amount = damage;
+		op.m_count = 1;
+		intention.m_ops.emplace_back(op);
+	}
+
+	int block = ParseXmlAttribute(intentionElement, "block", 0);
+	if (block != 0)
+	{
+		op = IntentionOp();
+		op.m_opCode = IntentionOpCode::BLOCK;
+		op.m_amount = block;
+		intention.m_ops.emplace_back(op);
+	}
+
+	std::string cardToAdd = ParseXmlAttribute(intentionElement, "cardToAdd", "invalid card");
+	if (CardDefinition::GetCardDefinition(cardToAdd) != nullptr)
+	{
+		op = IntentionOp();
+		op.m_opCode = IntentionOpCode::ADD_CARD;
+		op.m_card = CardDefinition::GetCardDefinition(cardToAdd);
+		intention.m_ops.emplace_back(op);
+	}
+
+	std::string gainEffect = ParseXmlAttribute(intentionElement, "gainEffect", "invalid effect");
+	if (EffectDefinition::GetEffectDefinition(gainEffect) != nullptr)
+	{
+		op = IntentionOp();
+		op.m_opCode = IntentionOpCode::GAIN;
+		op.m_effect = EffectDefinition::GetEffectDefinition(gainEffect);
+		op.m_count = ParseXmlAttribute(intentionElement, "gainEffectStack", 0);
+		intention.m_ops.emplace_back(op);
+	}
+
+	std::string inflictEffect = ParseXmlAttribute(intentionElement, "inflictEffect", "invalid effect");
+	if (EffectDefinition::GetEffectDefinition(inflictEffect) != nullptr)
+	{
+		op = IntentionOp();
+		op.m_opCode = IntentionOpCode::INFLICT;
+		op.m_effect = EffectDefinition::GetEffectDefinition(inflictEffect);
+		op.m_count = ParseXmlAttribute(intentionElement, "inflictEffectStack", 0);
+		intention.m_ops.emplace_back(op);
+	}
+}
+
+
+void EnemyDefinition::CompileIntentionFromActions(XmlElement const& intentionElement, Intention& intention) const
+{
+	XmlElement const* actionElement = intentionElement.FirstChildElement();
+	while (actionElement != nullptr)
+	{
+		std::string actionName = actionElement->Name();
+
+		IntentionOp op;
+		if (actionName == "Attack")
+		{
+			op.m_opCode = IntentionOpCode::ATTACK;
+			op.m_amount = ParseXmlAttribute(*actionElement, "damage", 0);
+			op.m_count = ParseXmlAttribute(*actionElement, "numHits", 1);
+		}
+		else if (actionName == "Block")
+		{
+			op.m_opCode = IntentionOpCode::BLOCK;
+			op.m_amount = ParseXmlAttribute(*actionElement, "block", 0);
+		}
+		else if (actionName == "AddCard")
+		{
+			std::string cardName = ParseXmlAttribute(*actionElement, "card", "invalid card");
+			op.m_opCode = IntentionOpCode::ADD_CARD;
+			op.m_card = CardDefinition::GetCardDefinition(cardName);
+			GUARANTEE_OR_DIE(op.m_card != nullptr, Stringf("Enemy \"%s\" adds unknown card \"%s\"!", m_name.c_str(), cardName.c_str()));
+
+			std::string pileName = ParseXmlAttribute(*actionElement, "pile", "Draw");
+			op.m_pile = GetAddCardPileFromName(pileName);
+			GUARANTEE_OR_DIE(op.m_pile != AddCardPile::INVALID, Stringf("Enemy \"%s\" adds \"%s\" to unknown pile \"%s\"!", m_name.c_str(), cardName.c_str(), pileName.c_str()));
+		}
+		else if (actionName == "Inflict" || actionName == "Gain")
+		{
+			std::string effectName = ParseXmlAttribute(*actionElement, "effect", "invalid effect");
+			op.m_opCode = (actionName == "Inflict") ? IntentionOpCode::INFLICT : IntentionOpCode::GAIN;
+			op.m_effect = EffectDefinition::GetEffectDefinition(effectName);
+			op.m_count = ParseXmlAttribute(*actionElement, "stack", 1);
+			GUARANTEE_OR_DIE(op.m_effect != nullptr, Stringf("Enemy \"%s\" uses unknown effect \"%s\"!", m_name.c_str(), effectName.c_str()));
+		}
+		else
+		{
+			ERROR_RECOVERABLE(Stringf("Enemy \"%s\" has unknown intention action <%s>, skipping it", m_name.c_str(), actionName.c_str()));
+			actionElement = actionElement->NextSiblingElement();
+			continue;
+		}
+
+		intention.m_ops.emplace_back(op);
+		actionElement = actionElement->NextSiblingElement();
+	}
+}
+
+
+void EnemyDefinition::BuildIntentionSummary(Intention& intention) const
+{
+	for (int opIndex = 0; opIndex < intention.m_ops.size(); opIndex++)
+	{
+		IntentionOp const& op = intention.m_ops[opIndex];
+
+		std::string actionText;
+		switch (op.m_opCode)
+		{
+		case IntentionOpCode::ATTACK:
+		{
+			//the display shows one attack, so an intention gets at most one
+			GUARANTEE_OR_DIE(intention.m_numHits == 0, Stringf("Enemy \"%s\" has an intention with more than one attack; use numHits instead!", m_name.c_str()));
+			intention.m_damage = op.m_amount;
+			intention.m_numHits = op.m_count;
+			break;
+		}
+		case IntentionOpCode::BLOCK:	intention.m_block += op.m_amount; break;
+		case IntentionOpCode::ADD_CARD: actionText = Stringf("Inflict: %s", op.m_card->m_name.c_str()); break;
+		case IntentionOpCode::INFLICT:	actionText = Stringf("Inflict: %i %s", op.m_count, op.m_effect->m_name.c_str()); break;
+		case IntentionOpCode::GAIN:		actionText = Stringf("Gain: %i %s", op.m_count, op.m_effect->m_name.c_str()); break;
+		}
+
+		if (!actionText.empty())
+		{
+			if (!intention.m_statusText.empty())
+			{
+				intention.m_statusText += ", ";
+			}
+			intention.m_statusText += actionText;
+		}
+	}
+
+	if (intention.m_statusText.empty() && intention.m_preparing)
+	{
+		intention.m_statusText = "Preparing...";
+	}
+}
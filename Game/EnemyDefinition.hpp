@@ -18,17 +18,48 @@ enum class IntentionMode
 };
 
 
+enum class IntentionOpCode : unsigned char
+{
+	ATTACK,		//m_amount damage m_count times to the player
+	BLOCK,		//m_amount block to the enemy
+	ADD_CARD,	//m_card put into the player's m_pile
+	INFLICT,	//m_count stacks of m_effect to the player
+	GAIN,		//m_count stacks of m_effect to the enemy
+};
+
+
+//where an ADD_CARD op puts its card; named by an AddCard action's pile attribute
+enum class AddCardPile : unsigned char
+{
+	DRAW,		//shuffled in at a random position
+	DISCARD,	//on top
+	INVALID
+};
+
+
+//one step of an intention; intentions only carry the steps they actually do, and run them in order
+struct IntentionOp
+{
+	CardDefinition const*	m_card = nullptr;
+	EffectDefinition const* m_effect = nullptr;
+	int						m_amount = 0;
+	int						m_count = 0;
+	IntentionOpCode			m_opCode = IntentionOpCode::ATTACK;
+	AddCardPile				m_pile = AddCardPile::DRAW;	//ADD_CARD only
+};
+
+
 //struct for enemy intentions
 struct Intention
 {
-	int m_damage = 0;
-	int m_block = 0;
-	CardDefinition const* m_cardToAdd = nullptr;
-	EffectDefinition const* m_inflictEffect = nullptr;
-	int m_inflictEffectStack = 0;
-	EffectDefinition const* m_gainEffect = nullptr;
-	int m_gainEffectStack = 0;
-	bool m_preparing = true;
+	std::vector<IntentionOp> m_ops;
+
+	//summary of the ops for the intention display, built once at load
+	int			m_damage = 0;	//per hit
+	int			m_numHits = 0;
+	int			m_block = 0;
+	std::string m_statusText;	//every bonus action, or "Preparing..." if there are none
+	bool		m_preparing = true;
 };
 
 
@@ -42,16 +73,27 @@ public:
 	//static functions
 	static void InitializeEnemyDefs();
 	static EnemyDefinition const* GetEnemyDefinition(std::string name);
+	static AddCardPile GetAddCardPileFromName(std::string const& pileName);
+	static bool IsValidXml(XmlElement const& element, std::string& out_problem);	//checks everything the constructor dies on, without dying
 
 //public member variables
 public:
 	//enemy parameters
 	std::string			   m_name = "invalid enemy";
 	Texture*			   m_sprite = nullptr;
+	AABB2				   m_spriteUVs = AABB2(0.0f, 0.0f, 1.0f, 1.0f);
 	int					   m_maxHealth = 0;
 	IntentionMode		   m_intentionMode = IntentionMode::INVALID;
 	std::vector<Intention> m_intentions;
+	int					   m_revision = 0;	//bumped each time the definition is hot reloaded
 	
 	//static variables
 	static std::vector<EnemyDefinition> s_enemyDefs;
+
+//private member functions
+private:
+	//intention compilation functions
+	void CompileIntentionFromParameters(XmlElement const& intentionElement, Intention& intention) const;
+	void CompileIntentionFromActions(XmlElement const& intentionElement, Intention& intention) const;
+	void BuildIntentionSummary(Intention& intention) const;
 };
@@ -9,6 +9,10 @@
 //
 
 //#define ENGINE_DISABLE_AUDIO	// (If uncommented) Disables AudioSystem code and fmod linkage.
-#if defined(_DEBUG)
-	#define ENGINE_DEBUG_RENDER
+#if defined(GAME_HEADLESS) || defined(GAME_NULL_PLATFORM)
+	#define ENGINE_DISABLE_AUDIO	// headless simulation and soak builds have no audio device (and no fmod on Linux)
+#endif
+
+#if (defined(_DEBUG) && !defined(GAME_HEADLESS)) || defined(GAME_NULL_PLATFORM)
+	#define ENGINE_DEBUG_RENDER		// soak builds always exercise the debug render vertex generation
 #endif
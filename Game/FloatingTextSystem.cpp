@@ -0,0 +1,182 @@
+#include "Game/FloatingTextSystem.hpp"
+#include "Game/AllocationTracker.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <stdio.h>
+
+
+//look of each FloatingTextStyle; the format receives the entry's value
+struct FloatingTextStyleDefinition
+{
+	char const* m_format;
+	Rgba8		m_color;
+	float		m_textHeight;
+	Vec2		m_alignment;
+};
+
+
+static FloatingTextStyleDefinition const s_floatingTextStyles[static_cast<int>(FloatingTextStyle::COUNT)] =
+{
+	{ "-%i",			Rgba8(255, 0, 0),	  30.0f, Vec2(1.0f, 1.0f) },	//DAMAGE
+	{ "-%i",			Rgba8(0, 100, 255),	  30.0f, Vec2(1.0f, 1.0f) },	//BLOCKED_DAMAGE
+	{ "+%i",			Rgba8(0, 100, 255),	  30.0f, Vec2(1.0f, 1.0f) },	//BLOCK
+	{ "+%i",			Rgba8(0, 255, 0),	  30.0f, Vec2(1.0f, 1.0f) },	//HEAL
+	{ "Debuff Blocked", Rgba8(255, 100, 0),	  27.5f, Vec2(0.5f, 1.0f) },	//DEBUFF_BLOCKED
+	{ "Debuff\nBlocked", Rgba8(255, 100, 0),  27.5f, Vec2(0.5f, 1.0f) },	//ENEMY_DEBUFF_BLOCKED
+};
+
+
+//
+//public game flow functions
+//
+void FloatingTextSystem::Update(float deltaSeconds)
+{
+	for (int entryIndex = 0; entryIndex < FLOATING_TEXT_CAPACITY; entryIndex++)
+	{
+		FloatingText& entry = m_entries[entryIndex];
+		if (entry.m_age >= FLOATING_TEXT_LIFETIME)
+		{
+			continue;
+		}
+
+		entry.m_age += deltaSeconds;
+		entry.m_position.y += FLOATING_TEXT_RISE_SPEED * deltaSeconds;
+	}
+}
+
+
+void FloatingTextSystem::Render() const
+{
+	FloatingTextSnapshot const& snapshot = m_snapshots[1 - m_buildingSnapshotIndex];
+	if (snapshot.m_textVerts.empty())
+	{
+		return;
+	}
+
+	g_theRenderer->BindTexture(&g_font->GetTexture());
+	g_theRenderer->DrawVertexArray(snapshot.m_textVerts);
+}
+
+
+void FloatingTextSystem::Clear()
+{
+	for (int entryIndex = 0; entryIndex < FLOATING_TEXT_CAPACITY; entryIndex++)
+	{
+		m_entries[entryIndex].m_age = FLOATING_TEXT_LIFETIME;
+	}
+
+	m_nextEntryIndex = 0;
+
+	//neither snapshot is being built, so the frame after the clear draws nothing from before it
+	m_snapshots[0].m_textVerts.clear();
+	m_snapshots[1].m_textVerts.clear();
+}
+
+
+bool FloatingTextSystem::IsActive() const
+{
+	for (int entryIndex = 0; entryIndex < FLOATING_TEXT_CAPACITY; entryIndex++)
+	{
+		if (m_entries[entryIndex].m_age < FLOATING_TEXT_LIFETIME)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//
+//public snapshot functions
+//
+FloatingTextSnapshot* FloatingTextSystem::PublishSnapshot(float secondsSinceTick)
+{
+	//the snapshot just built becomes the drawn one, and the one drawn last frame is refilled for building
+	m_buildingSnapshotIndex = 1 - m_buildingSnapshotIndex;
+
+	FloatingTextSnapshot& snapshot = m_snapshots[m_buildingSnapshotIndex];
+	for (int entryIndex = 0; entryIndex < FLOATING_TEXT_CAPACITY; entryIndex++)
+	{
+		snapshot.m_entries[entryIndex] = m_entries[entryIndex];
+	}
+	snapshot.m_secondsSinceTick = secondsSinceTick;
+	snapshot.m_textVerts.clear();
+
+	return &snapshot;
+}
+
+
+void FloatingTextSystem::BuildSnapshotVerts(void* snapshotData)
+{
+	ScopedAllocationTag allocationTag(AllocationTag::UI_TEXT);
+
+	FloatingTextSnapshot& snapshot = *static_cast<FloatingTextSnapshot*>(snapshotData);
+	float secondsSinceTick = snapshot.m_secondsSinceTick;
+
+	char text[FLOATING_TEXT_MAX_LENGTH + 1];
+	float fadeStartAge = FLOATING_TEXT_LIFETIME * (1.0f - FLOATING_TEXT_FADE_FRACTION);
+
+	for (int entryIndex = 0; entryIndex < FLOATING_TEXT_CAPACITY; entryIndex++)
+	{
+		FloatingText const& entry = snapshot.m_entries[entryIndex];
+		if (entry.m_age >= FLOATING_TEXT_LIFETIME)
+		{
+			continue;
+		}
+
+		float renderAge = entry.m_age + secondsSinceTick;
+		Vec2 renderPosition = Vec2(entry.m_position.x, entry.m_position.y + FLOATING_TEXT_RISE_SPEED * secondsSinceTick);
+
+		FloatingTextStyleDefinition const& style = s_floatingTextStyles[static_cast<int>(entry.m_style)];
+		snprintf(text, sizeof(text), style.m_format, entry.m_value);
+
+		Rgba8 color = style.m_color;
+		color.a = static_cast<unsigned char>(255.0f * RangeMapClamped(renderAge, fadeStartAge, FLOATING_TEXT_LIFETIME, 1.0f, 0.0f));
+
+		//multi-line text is aligned as one block, with each line aligned horizontally on its own
+		int numLines = 1;
+		for (int charIndex = 0; text[charIndex] != '\0'; charIndex++)
+		{
+			if (text[charIndex] == '\n')
+			{
+				numLines++;
+			}
+		}
+
+		float blockMinY = renderPosition.y - style.m_textHeight * static_cast<float>(numLines) * style.m_alignment.y;
+		char const* lineStart = text;
+		for (int lineIndex = 0; lineIndex < numLines; lineIndex++)
+		{
+			char const* lineEnd = lineStart;
+			while (*lineEnd != '\0' && *lineEnd != '\n')
+			{
+				lineEnd++;
+			}
+			std::string const lineString = std::string(lineStart, lineEnd);
+
+			float lineWidth = g_font->GetTextWidth(style.m_textHeight, lineString);
+			float lineMinY = blockMinY + style.m_textHeight * static_cast<float>(numLines - 1 - lineIndex);
+			Vec2 lineMins = Vec2(renderPosition.x - lineWidth * style.m_alignment.x, lineMinY);
+			g_font->AddVertsForText2D(snapshot.m_textVerts, lineMins, style.m_textHeight, lineString, color);
+
+			lineStart = (*lineEnd == '\n') ? lineEnd + 1 : lineEnd;
+		}
+	}
+}
+
+
+//
+//public spawning functions
+//
+void FloatingTextSystem::Spawn(FloatingTextStyle style, int value, Vec2 const& position)
+{
+	FloatingText& entry = m_entries[m_nextEntryIndex];
+	entry.m_position = position;
+	entry.m_age = 0.0f;
+	entry.m_value = value;
+	entry.m_style = style;
+
+	m_nextEntryIndex = (m_nextEntryIndex + 1) % FLOATING_TEXT_CAPACITY;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include <vector>
+
+
+//constants
+constexpr int FLOATING_TEXT_CAPACITY = 64;
+constexpr float FLOATING_TEXT_LIFETIME = 2.0f;
+constexpr float FLOATING_TEXT_RISE_SPEED = 20.0f;
+constexpr float FLOATING_TEXT_FADE_FRACTION = 0.5f;	//fraction of the lifetime, at the end, spent fading out
+constexpr int FLOATING_TEXT_MAX_LENGTH = 15;		//short enough that formatted text never leaves std::string's inline buffer
+
+
+//how a floating text entry is formatted and drawn; see s_floatingTextStyles for each one's look
+enum class FloatingTextStyle : unsigned char
+{
+	DAMAGE,
+	BLOCKED_DAMAGE,
+	BLOCK,
+	HEAL,
+	DEBUFF_BLOCKED,
+	ENEMY_DEBUFF_BLOCKED,
+	COUNT
+};
+
+
+struct FloatingText
+{
+	Vec2			  m_position;
+	float			  m_age = FLOATING_TEXT_LIFETIME;	//entries at or past their lifetime are free
+	int				  m_value = 0;
+	FloatingTextStyle m_style = FloatingTextStyle::DAMAGE;
+};
+
+
+//one published copy of the pool and the vertexes built from it
+struct FloatingTextSnapshot
+{
+	FloatingText			m_entries[FLOATING_TEXT_CAPACITY];
+	float					m_secondsSinceTick = 0.0f;
+	std::vector<Vertex_PCU> m_textVerts;	//kept between frames so its capacity is reused
+};
+
+
+//fixed pool of rising, fading combat numbers drawn with the game font
+//spawning never allocates; when the pool is full the oldest entry is reused
+//after each update the pool is copied into one of two snapshots, and its vertexes are built from that copy off the main thread;
+//render draws the other snapshot, finished during the previous frame, so the build overlaps this frame's render and next update
+//at the cost of the text trailing the rest of the scene by one frame
+//all live entries are batched into one vertex array and drawn with a single draw call
+class FloatingTextSystem
+{
+//public member functions
+public:
+	//game flow functions
+	void Update(float deltaSeconds);
+	void Render() const;	//draws the snapshot built from the previous frame's publish
+	void Clear();			//the snapshot build job must have finished
+	bool IsActive() const;
+
+	//snapshot functions
+	FloatingTextSnapshot* PublishSnapshot(float secondsSinceTick);	//the previous build job must have finished; entries are drawn this far past their last update
+	static void BuildSnapshotVerts(void* snapshotData);				//RenderPrepJob; reads only the snapshot and the font
+
+	//spawning functions
+	void Spawn(FloatingTextStyle style, int value, Vec2 const& position);
+
+//private member variables
+private:
+	FloatingText m_entries[FLOATING_TEXT_CAPACITY];
+	int			 m_nextEntryIndex = 0;	//entries all live equally long, so the next one in order is always the oldest
+
+	//the building snapshot belongs to the render prep worker until the next publish; the other one is only read by Render
+	FloatingTextSnapshot m_snapshots[2];
+	int					 m_buildingSnapshotIndex = 0;
+};
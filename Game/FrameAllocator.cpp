@@ -0,0 +1,107 @@
+#include "Game/FrameAllocator.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+
+FrameAllocator g_frameAllocator;
+
+
+FrameAllocator::~FrameAllocator()
+{
+	Reset();
+
+	delete[] m_block;
+	m_block = nullptr;
+}
+
+
+//
+//public allocation functions
+//
+void* FrameAllocator::Allocate(size_t numBytes, size_t alignment)
+{
+	GUARANTEE_OR_DIE(alignment <= alignof(std::max_align_t), "FrameAllocator can't align past max_align_t!");
+
+	if (m_block == nullptr)
+	{
+		m_blockSize = FRAME_ALLOCATOR_INITIAL_BYTES;
+		m_block = new unsigned char[m_blockSize];
+	}
+
+	size_t alignedOffset = (m_blockOffset + alignment - 1) & ~(alignment - 1);
+	if (alignedOffset + numBytes <= m_blockSize)
+	{
+		m_blockOffset = alignedOffset + numBytes;
+		return m_block + alignedOffset;
+	}
+
+	//out of room this frame; new[] already aligns to max_align_t
+	unsigned char* overflowBlock = new unsigned char[numBytes];
+	m_overflowBlocks.emplace_back(overflowBlock);
+	m_numOverflowBytes += numBytes;
+	return overflowBlock;
+}
+
+
+void FrameAllocator::Reset()
+{
+	if (!m_overflowBlocks.empty())
+	{
+		for (int overflowIndex = 0; overflowIndex < m_overflowBlocks.size(); overflowIndex++)
+		{
+			delete[] m_overflowBlocks[overflowIndex];
+		}
+		m_overflowBlocks.clear();
+
+		//grow to fit everything the frame asked for, with room to spare so a slightly busier frame doesn't spill again
+		size_t frameBytes = m_blockSize + m_numOverflowBytes;
+		m_blockSize = frameBytes + frameBytes / 2;
+		delete[] m_block;
+		m_block = new unsigned char[m_blockSize];
+		m_numOverflowBytes = 0;
+	}
+
+	m_blockOffset = 0;
+}
+
+
+//
+//public accessors
+//
+size_t FrameAllocator::GetNumBytesUsed() const
+{
+	return m_blockOffset + m_numOverflowBytes;
+}
+
+
+size_t FrameAllocator::GetCapacity() const
+{
+	return m_blockSize;
+}
+
+
+//
+//frame vertex functions
+//
+void AddVertsForAABB2(FrameVerts& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& uvs)
+{
+	Vec3 bottomLeft = Vec3(bounds.m_mins.x, bounds.m_mins.y, 0.0f);
+	Vec3 bottomRight = Vec3(bounds.m_maxs.x, bounds.m_mins.y, 0.0f);
+	Vec3 topRight = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0.0f);
+	Vec3 topLeft = Vec3(bounds.m_mins.x, bounds.m_maxs.y, 0.0f);
+
+	verts.push_back(Vertex_PCU(bottomLeft, color, uvs.m_mins));
+	verts.push_back(Vertex_PCU(bottomRight, color, Vec2(uvs.m_maxs.x, uvs.m_mins.y)));
+	verts.push_back(Vertex_PCU(topRight, color, uvs.m_maxs));
+
+	verts.push_back(Vertex_PCU(bottomLeft, color, uvs.m_mins));
+	verts.push_back(Vertex_PCU(topRight, color, uvs.m_maxs));
+	verts.push_back(Vertex_PCU(topLeft, color, Vec2(uvs.m_mins.x, uvs.m_maxs.y)));
+}
+
+
+void DrawFrameVerts(FrameVerts const& verts)
+{
+	g_theRenderer->DrawVertexArray(static_cast<int>(verts.size()), verts.data());
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include <cstddef>
+#include <vector>
+
+
+//constants
+constexpr size_t FRAME_ALLOCATOR_INITIAL_BYTES = 256 * 1024;
+
+
+//hands out memory that only lives until the end of the frame; allocating is a pointer bump and nothing is freed on its own
+//App::EndFrame resets it, so nothing allocated from it can be kept past the frame that allocated it
+//a frame that runs past the end of the block spills into overflow blocks, and the next reset grows the block to fit that
+//frame, so once the game has shown its busiest screen it never goes back to the heap
+//only the main thread renders, so it isn't thread safe
+class FrameAllocator
+{
+//public member functions
+public:
+	FrameAllocator() = default;
+	~FrameAllocator();
+	FrameAllocator(FrameAllocator const& copyFrom) = delete;
+	FrameAllocator& operator=(FrameAllocator const& copyFrom) = delete;
+
+	//allocation functions
+	void* Allocate(size_t numBytes, size_t alignment);
+	void Reset();
+
+	//accessors
+	size_t GetNumBytesUsed() const;
+	size_t GetCapacity() const;
+
+//private member variables
+private:
+	unsigned char*				m_block = nullptr;
+	size_t						m_blockSize = 0;
+	size_t						m_blockOffset = 0;
+	std::vector<unsigned char*> m_overflowBlocks;
+	size_t						m_numOverflowBytes = 0;
+};
+
+
+extern FrameAllocator g_frameAllocator;
+
+
+//lets standard containers allocate from g_frameAllocator; deallocate does nothing, it all goes back at the end of the frame
+template <typename T>
+class FrameAllocatorAdapter
+{
+//public member functions
+public:
+	typedef T value_type;
+
+	FrameAllocatorAdapter() = default;
+	template <typename U>
+	FrameAllocatorAdapter(FrameAllocatorAdapter<U> const& copyFrom) { UNUSED(copyFrom); }
+
+	T* allocate(size_t count)
+	{
+		return static_cast<T*>(g_frameAllocator.Allocate(count * sizeof(T), alignof(T)));
+	}
+	void deallocate(T* memory, size_t count)
+	{
+		UNUSED(memory);
+		UNUSED(count);
+	}
+};
+
+
+template <typename T, typename U>
+bool operator==(FrameAllocatorAdapter<T> const& a, FrameAllocatorAdapter<U> const& b)
+{
+	UNUSED(a);
+	UNUSED(b);
+	return true;
+}
+
+
+template <typename T, typename U>
+bool operator!=(FrameAllocatorAdapter<T> const& a, FrameAllocatorAdapter<U> const& b)
+{
+	return !(a == b);
+}
+
+
+//typedefs
+typedef std::vector<Vertex_PCU, FrameAllocatorAdapter<Vertex_PCU>> FrameVerts;
+
+
+//frame vertex functions; the engine's vertex utilities only fill std::vector, so the shapes the game draws every frame have their own
+void AddVertsForAABB2(FrameVerts& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& uvs = AABB2(0.0f, 0.0f, 1.0f, 1.0f));
+void DrawFrameVerts(FrameVerts const& verts);
@@ -1,4 +1,5 @@
 #include "Game/Game.hpp"
+#include "Game/SpriteAtlas.hpp"
 #include "Game/App.hpp"
 #include "Game/Player.hpp"
 #include "Game/Enemy.hpp"
@@ -8,6 +9,8 @@
 #include "Game/EnemyDefinition.hpp"
 #include "Game/EffectDefinition.hpp"
 #include "Game/SaveManager.hpp"
+#include "Game/RunTelemetry.hpp"
+#include "Game/AllocationTracker.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
@@ -34,6 +37,19 @@ void Game::Startup()
 
 	//initialize all definitions
 	InitializeDefinitions();
+
+	//debug builds watch the data files by default; anything else only does if the config asks for it
+#if defined(_DEBUG)
+	bool isHotReloadDefault = true;
+#else
+	bool isHotReloadDefault = false;
+#endif
+	if (g_gameConfigBlackboard.GetValue("hotReloadDefinitions", isHotReloadDefault))
+	{
+		m_definitionReloader.Startup();
+	}
+
+	m_renderPrepWorker.Startup();
 	
 	//set camera bounds
 	m_screenCamera.SetOrthoView(Vec2(0.f, 0.f), Vec2(SCREEN_CAMERA_SIZE_X, SCREEN_CAMERA_SIZE_Y));
@@ -78,6 +94,8 @@ void Game::Startup()
 	m_restButton = new Button(g_theRenderer, g_theInput, restButtonBounds, screenBounds, nullptr, "Rest", AABB2(0.1f, 0.1f, 0.9f, 0.9f), Rgba8(40, 0, 0));
 	m_restButton->SubscribeToEvent("Player Rest", Game::Event_PlayerRest);
 
+	SubscribeEventCallbackFunction("playbackrate", Game::Event_SetPlaybackRate);
+
 	//check for save file
 	m_loadedFile = CheckForFile("Save.bin");
 
@@ -87,6 +105,9 @@ void Game::Startup()
 
 void Game::Update()
 {
+	//pick up definition edits before anything reads them this frame
+	m_definitionReloader.Update();
+
 	//if in attract mode, just update that and don't bother with anything else
 	if (m_isAttractMode)
 	{
@@ -121,103 +142,51 @@ void Game::Update()
 		return;
 	}
 
-	//speed up control
+	//speed up control, cycles through the preset playback rates
 	if (g_theInput->WasKeyJustPressed('T'))
 	{
-		if (m_gameClock.GetTimeScale() == 1.0f)
-		{
-			m_gameClock.SetTimeScale(5.0f);
-			std::string debugMessage = "Set time scale to 5";
-			DebugAddMessage(debugMessage, 2.5f);
-		}
-		else
+		int nextRateIndex = 0;
+		for (int rateIndex = 0; rateIndex < NUM_PLAYBACK_RATES; rateIndex++)
 		{
-			m_gameClock.SetTimeScale(1.0f);
-			std::string debugMessage = "Set time scale to 1";
-			DebugAddMessage(debugMessage, 2.5f);
+			if (PLAYBACK_RATES[rateIndex] == m_playbackRate)
+			{
+				nextRateIndex = (rateIndex + 1) % NUM_PLAYBACK_RATES;
+				break;
+			}
 		}
-	}
 
-	if (m_map->m_isRestTime)
-	{
-		m_map->UpdateRestStop();
-		m_restButton->Update();
-		m_skipButton->Update();
-		return;
+		SetPlaybackRate(PLAYBACK_RATES[nextRateIndex]);
 	}
 
-	Encounter* currentEncounter = m_map->m_allEncounters[m_map->m_currentEncounterNumber];
-
-	//debug control to insta-win encounter
-	if (g_theInput->WasKeyJustPressed(KEYCODE_SHIFT))
+	//rules and presentation advance in fixed ticks, decoupled from the frame rate
+	UpdateLogicTicks();
+	if (IsLogicStopped())
 	{
-		currentEncounter->KillAllEnemies();
+		return;
 	}
 
-	//game over
-	if (m_player->m_currentHealth == 0)
+	//the end-of-encounter banners are drawn for a single frame, so they're added once per frame rather than per tick
+	if (!m_map->m_isRestTime)
 	{
-		DebugAddScreenText("GAME OVER", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_CENTER_Y), 150.0f, Vec2(0.5f, 0.5f), 0.0f, Rgba8(255, 0, 0), Rgba8(255, 0, 0));
-
-		m_encounterEndTimer -= m_gameClock.GetDeltaSeconds();
-
-		if (m_encounterEndTimer <= 0.0f)
+		Encounter const* currentEncounter = m_map->m_allEncounters[m_map->m_currentEncounterNumber];
+		if (m_player->m_currentHealth == 0 && !m_combatTimeline.IsPlaying())
 		{
-			m_encounterEndTimer = 3.0f;
-			m_isFinished = true;
-			m_isGameOver = true;
+			DebugAddScreenText("GAME OVER", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_CENTER_Y), 150.0f, Vec2(0.5f, 0.5f), 0.0f, Rgba8(255, 0, 0), Rgba8(255, 0, 0));
 		}
-
-		return;
-	}
-	//player wins encounter
-	if (!currentEncounter->m_cardRewardScreenOpen && currentEncounter->AreAllEnemiesDead())
-	{
-		DebugAddScreenText("Victory!", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_CENTER_Y), 150.0f, Vec2(0.5f, 0.5f), 0.0f, Rgba8(0, 255, 0), Rgba8(0, 255, 0));
-
-		m_encounterEndTimer -= m_gameClock.GetDeltaSeconds();
-
-		if (m_encounterEndTimer <= 0.0f)
+		else if (IsEncounterOver(currentEncounter))
 		{
-			m_encounterEndTimer = 3.0f;
-			if (currentEncounter->m_encounterNumber == m_map->m_allEncounters.size() - 1)
-			{
-				m_isVictory = true;
-				g_theAudio->StopSound(g_finalBossMusicPlayback);
-				g_victoryMusicPlayback = g_theAudio->StartSound(g_victoryMusic);
-			}
-			else
-			{
-				currentEncounter->OpenCardRewardScreen();
-			}
+			DebugAddScreenText("Victory!", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_CENTER_Y), 150.0f, Vec2(0.5f, 0.5f), 0.0f, Rgba8(0, 255, 0), Rgba8(0, 255, 0));
 		}
-
-		return;
 	}
 
-	m_player->Update();
-
-	currentEncounter->Update();
-
-	if (!currentEncounter->m_cardRewardScreenOpen)
-	{
-		if (currentEncounter->m_turnState == TurnState::PLAYER)
-		{
-			m_endTurnButton->Update();
-		}
-
-		m_drawPileButton->Update();
-		m_discardPileButton->Update();
-	}
-	else
-	{
-		m_skipButton->Update();
-	}
+	UpdateInput();
 }
 
 
 void Game::Render() const
 {
+	ScopedAllocationTag allocationTag(AllocationTag::RENDER);
+
 	//if in attract mode, just render that and not anything else
 	if (m_isAttractMode)
 	{
@@ -258,6 +227,9 @@ void Game::Render() const
 		}
 	}
 
+	//built on the render prep worker during the previous frame, so there's nothing to wait for
+	m_floatingText.Render();
+
 	g_theRenderer->EndCamera(m_screenCamera);
 
 	DebugRenderScreen(m_screenCamera);
@@ -279,6 +251,9 @@ void Game::Shutdown()
 	g_theAudio->StopSound(g_finalVictoryMusicPlayback);
 	g_theAudio->StopSound(g_campfireSoundPlayback);
 
+	//the worker may still be reading this game's snapshot
+	m_renderPrepWorker.Shutdown();
+
 	//save progress if there's progress to save
 	if (!m_isGameOver && m_player != nullptr)
 	{
@@ -346,12 +321,68 @@ void Game::Shutdown()
 //
 //public game utilities
 //
+void Game::PublishRenderSnapshot()
+{
+	//logic is done for the frame, so what it left is copied out and built on the worker during this render and the next update
+	//the previous build normally finished long ago; it has to have, since the snapshot it built is the one drawn next
+	m_renderPrepWorker.WaitUntilIdle();
+	FloatingTextSnapshot* floatingTextSnapshot = m_floatingText.PublishSnapshot(m_logicAccumulatorSeconds);
+	m_renderPrepWorker.Kick(FloatingTextSystem::BuildSnapshotVerts, floatingTextSnapshot);
+}
+
+
 void Game::BeginScreenShake(float screenShakeAmount)
 {
 	m_cameraOffsetAmount = screenShakeAmount;
 }
 
 
+//true when the screen only changes in response to input: nothing animating, playing out or counting down
+//the rest stop's fire flicker and the title screen are fine at the idle redraw rate
+bool Game::IsIdle() const
+{
+	if (m_isAttractMode || m_isVictory || m_map->m_isRestTime)
+	{
+		return true;
+	}
+
+	if (m_cameraOffsetAmount > 0.0f || !m_combatEvents.IsEmpty() || m_combatTimeline.IsPlaying() || m_floatingText.IsActive())
+	{
+		return false;
+	}
+
+	Encounter const* currentEncounter = m_map->m_allEncounters[m_map->m_currentEncounterNumber];
+	if (m_player->m_currentHealth == 0 || IsEncounterOver(currentEncounter))
+	{
+		return false;
+	}
+
+	return !m_player->IsFlashing() && !currentEncounter->IsAnyEnemyFlashing();
+}
+
+
+void Game::SetPlaybackRate(float playbackRate)
+{
+	m_playbackRate = playbackRate;
+
+	if (playbackRate > 0.0f)
+	{
+		m_gameClock.SetTimeScale(playbackRate);
+		DebugAddMessage(Stringf("Set playback rate to %.2f", playbackRate), 2.5f);
+	}
+	else if (playbackRate == PLAYBACK_RATE_UNCAPPED)
+	{
+		m_gameClock.SetTimeScale(1.0f);
+		DebugAddMessage("Fast-forwarding combat, uncapped", 2.5f);
+	}
+	else
+	{
+		m_gameClock.SetTimeScale(1.0f);
+		DebugAddMessage("Skipping combat presentation", 2.5f);
+	}
+}
+
+
 //
 //public static functions
 //
@@ -360,7 +391,7 @@ bool Game::Event_EndTurn(EventArgs& args)
 	UNUSED(args);
 	
 	Encounter* currentEncounter = g_theGame->m_map->m_allEncounters[g_theGame->m_map->m_currentEncounterNumber];
-	currentEncounter->ChangeTurnState(TurnState::ENEMY);
+	currentEncounter->ResolveEnemyTurn();
 
 	return true;
 }
@@ -431,12 +462,31 @@ bool Game::Event_SkipCard(EventArgs& args)
 {
 	UNUSED(args);
 	
+	g_runTelemetry.RecordRewardSkipped();
 	g_theGame->m_map->EnterNextEncounter();
 
 	return true;
 }
 
 
+bool Game::Event_SetPlaybackRate(EventArgs& args)
+{
+	float playbackRate = args.GetValue("rate", 1.0f);
+	if (playbackRate < 0.0f)
+	{
+		return false;
+	}
+	if (args.GetValue("uncapped", false))
+	{
+		playbackRate = PLAYBACK_RATE_UNCAPPED;
+	}
+
+	g_theGame->SetPlaybackRate(playbackRate);
+
+	return true;
+}
+
+
 bool Game::Event_PlayerRest(EventArgs& args)
 {
 	UNUSED(args);
@@ -455,6 +505,184 @@ bool Game::Event_PlayerRest(EventArgs& args)
 //
 //game flow sub-functions
 //
+void Game::UpdateLogicTicks()
+{
+	//fast-forward: tick until this frame's share of real time is spent, for as long as there's something to play out
+	if (m_playbackRate == PLAYBACK_RATE_UNCAPPED && IsFastForwardable())
+	{
+		m_logicAccumulatorSeconds = 0.0f;
+
+		double budgetEndTime = GetCurrentTimeSeconds() + FAST_FORWARD_BUDGET_SECONDS;
+		do
+		{
+			UpdateLogicTick(LOGIC_TICK_SECONDS);
+		}
+		while (!IsLogicStopped() && IsFastForwardable() && GetCurrentTimeSeconds() < budgetEndTime);
+
+		return;
+	}
+
+	//otherwise tick as many times as the game clock has advanced, which the playback rate already scales
+	m_logicAccumulatorSeconds += m_gameClock.GetDeltaSeconds();
+
+	int numTicks = 0;
+	while (m_logicAccumulatorSeconds >= LOGIC_TICK_SECONDS && numTicks < MAX_LOGIC_TICKS_PER_FRAME && !IsLogicStopped())
+	{
+		UpdateLogicTick(LOGIC_TICK_SECONDS);
+		m_logicAccumulatorSeconds -= LOGIC_TICK_SECONDS;
+		numTicks++;
+	}
+
+	if (m_logicAccumulatorSeconds >= LOGIC_TICK_SECONDS)
+	{
+		m_logicAccumulatorSeconds = 0.0f;
+	}
+}
+
+
+void Game::UpdateLogicTick(float deltaSeconds)
+{
+	//present combat that has already been resolved, or drop it if presentation is being skipped
+	if (m_playbackRate != 0.0f)
+	{
+		m_combatTimeline.ConsumeEvents(m_combatEvents);
+		m_combatTimeline.Update(deltaSeconds);
+	}
+	else
+	{
+		m_combatEvents.DropAll();
+		m_combatTimeline.Skip();
+	}
+
+	m_floatingText.Update(deltaSeconds);
+
+	if (m_map->m_isRestTime)
+	{
+		m_map->UpdateRestStop();
+		return;
+	}
+
+	Encounter* currentEncounter = m_map->m_allEncounters[m_map->m_currentEncounterNumber];
+
+	//game over, once the killing blow has been shown
+	if (m_player->m_currentHealth == 0 && !m_combatTimeline.IsPlaying())
+	{
+		m_encounterEndTimer -= deltaSeconds;
+
+		if (m_encounterEndTimer <= 0.0f)
+		{
+			m_encounterEndTimer = 3.0f;
+			m_isFinished = true;
+			m_isGameOver = true;
+			EndTelemetryRun(false);
+		}
+
+		return;
+	}
+	//player wins encounter
+	if (IsEncounterOver(currentEncounter))
+	{
+		m_encounterEndTimer -= deltaSeconds;
+
+		if (m_encounterEndTimer <= 0.0f)
+		{
+			m_encounterEndTimer = 3.0f;
+			if (currentEncounter->m_encounterNumber == m_map->m_allEncounters.size() - 1)
+			{
+				m_isVictory = true;
+				EndTelemetryRun(true);
+				g_theAudio->StopSound(g_finalBossMusicPlayback);
+				g_victoryMusicPlayback = g_theAudio->StartSound(g_victoryMusic);
+			}
+			else
+			{
+				currentEncounter->OpenCardRewardScreen();
+			}
+		}
+
+		return;
+	}
+
+	m_player->Update(deltaSeconds);
+
+	currentEncounter->Update(deltaSeconds);
+}
+
+
+void Game::UpdateInput()
+{
+	if (m_map->m_isRestTime)
+	{
+		m_restButton->Update();
+		m_skipButton->Update();
+		return;
+	}
+
+	Encounter* currentEncounter = m_map->m_allEncounters[m_map->m_currentEncounterNumber];
+
+	//debug control to insta-win encounter
+	if (g_theInput->WasKeyJustPressed(KEYCODE_SHIFT))
+	{
+		currentEncounter->KillAllEnemies();
+	}
+
+	//nothing to click while the game over or victory banner is up
+	if ((m_player->m_currentHealth == 0 && !m_combatTimeline.IsPlaying()) || IsEncounterOver(currentEncounter))
+	{
+		return;
+	}
+
+	//the player can't act until the enemy turn has finished playing out
+	bool isPlayerInputAllowed = !m_combatTimeline.IsPlayingBeats();
+
+	//resolve clicks on cards, enemies and the playing field with one lookup; buttons still handle their own clicks
+	if (isPlayerInputAllowed && g_theInput->WasKeyJustPressed(KEYCODE_LMB))
+	{
+		DispatchClick(currentEncounter);
+	}
+
+	if (!currentEncounter->m_cardRewardScreenOpen)
+	{
+		if (currentEncounter->m_turnState == TurnState::PLAYER && isPlayerInputAllowed)
+		{
+			m_endTurnButton->Update();
+		}
+
+		m_drawPileButton->Update();
+		m_discardPileButton->Update();
+	}
+	else
+	{
+		m_skipButton->Update();
+	}
+}
+
+
+bool Game::IsLogicStopped() const
+{
+	return m_isFinished || m_isVictory || m_isAttractMode;
+}
+
+
+bool Game::IsFastForwardable() const
+{
+	if (m_map->m_isRestTime)
+	{
+		return false;
+	}
+
+	//combat still playing out, or an end-of-encounter banner counting down; anything else is waiting on the player
+	Encounter const* currentEncounter = m_map->m_allEncounters[m_map->m_currentEncounterNumber];
+	return m_combatTimeline.IsPlaying() || m_player->m_currentHealth == 0 || IsEncounterOver(currentEncounter);
+}
+
+
+bool Game::IsEncounterOver(Encounter const* currentEncounter) const
+{
+	return !currentEncounter->m_cardRewardScreenOpen && currentEncounter->AreAllEnemiesDead() && !m_combatTimeline.IsPlaying();
+}
+
+
 void Game::UpdateAttract()
 {
 	m_startButton->Update();
@@ -488,6 +716,80 @@ void Game::RenderAttract() const
 }
 
 
+//
+//click dispatch functions
+//
+void Game::DispatchClick(Encounter* currentEncounter)
+{
+	UpdateHitTestLayout(currentEncounter);
+
+	Vec2 mousePosition = g_theInput->GetCursorNormalizedPosition();
+
+	ClickEvent clickEvent;
+	clickEvent.m_position = Vec2(mousePosition.x * SCREEN_CAMERA_SIZE_X, mousePosition.y * SCREEN_CAMERA_SIZE_Y);
+	clickEvent.m_target = m_hitTestIndex.QueryPoint(clickEvent.m_position);
+
+	switch (clickEvent.m_target.m_type)
+	{
+	case HitTargetType::HAND_CARD:	   m_player->OnHandCardClicked(clickEvent.m_target.m_index); break;
+	case HitTargetType::ENEMY:		   m_player->OnPlayingFieldClicked(currentEncounter->m_currentEnemies[clickEvent.m_target.m_index]); break;
+	case HitTargetType::PLAYING_FIELD: m_player->OnPlayingFieldClicked(nullptr); break;
+	case HitTargetType::REWARD_CARD:   currentEncounter->AcceptCardReward(clickEvent.m_target.m_index); break;
+	default:						   break;	//buttons fire their own events, and empty space does nothing
+	}
+}
+
+
+void Game::UpdateHitTestLayout(Encounter const* currentEncounter)
+{
+	HitTestLayout layout;
+	layout.m_encounter = currentEncounter;
+	layout.m_handSize = static_cast<int>(m_player->m_hand.size());
+	layout.m_isRewardScreen = currentEncounter->m_cardRewardScreenOpen;
+
+	if (layout == m_hitTestLayout)
+	{
+		return;
+	}
+
+	m_hitTestLayout = layout;
+	m_hitTestIndex.Clear();
+
+	if (layout.m_isRewardScreen)
+	{
+		for (int rewardIndex = 0; rewardIndex < NUM_CARD_REWARDS; rewardIndex++)
+		{
+			m_hitTestIndex.AddRegion(CardLayout::GetRewardSlotBounds(rewardIndex, NUM_CARD_REWARDS), HitTargetType::REWARD_CARD, rewardIndex);
+		}
+
+		m_hitTestIndex.AddRegion(m_skipButton->m_bounds, HitTargetType::BUTTON, 0);
+		return;
+	}
+
+	m_hitTestIndex.AddRegion(AABB2(0.0f, 255.0f, SCREEN_CAMERA_SIZE_X, SCREEN_CAMERA_SIZE_Y), HitTargetType::PLAYING_FIELD, 0);
+
+	//enemy slots stay put for the whole encounter, dead enemies are filtered out when the click is handled
+	for (int enemyIndex = 0; enemyIndex < currentEncounter->m_currentEnemies.size(); enemyIndex++)
+	{
+		Enemy const* enemy = currentEncounter->m_currentEnemies[enemyIndex];
+		if (enemy != nullptr)
+		{
+			m_hitTestIndex.AddRegion(enemy->m_renderBounds, HitTargetType::ENEMY, enemyIndex);
+		}
+	}
+
+	//hand cards are registered in render order, so the card drawn on top of an overlap wins the click
+	for (int handIndex = 0; handIndex < layout.m_handSize; handIndex++)
+	{
+		m_hitTestIndex.AddRegion(m_player->m_handLayout.GetHandSlotBounds(handIndex, layout.m_handSize), HitTargetType::HAND_CARD, handIndex);
+	}
+
+	m_hitTestIndex.AddRegion(m_endTurnButton->m_bounds, HitTargetType::BUTTON, 0);
+	m_hitTestIndex.AddRegion(m_drawPileButton->m_bounds, HitTargetType::BUTTON, 1);
+	m_hitTestIndex.AddRegion(m_discardPileButton->m_bounds, HitTargetType::BUTTON, 2);
+}
+
+
 //
 //mode switching functions
 //
@@ -502,10 +804,17 @@ void Game::EnterAttractMode()
 void Game::EnterGameplay(bool loadFile)
 {
 	m_isAttractMode = false;
+	m_hitTestLayout = HitTestLayout();
+	m_combatEvents.DropAll();
+	m_combatTimeline.Clear();
+	m_renderPrepWorker.WaitUntilIdle();
+	m_floatingText.Clear();
+	m_logicAccumulatorSeconds = 0.0f;
 
 	g_theAudio->StopSound(g_startMenuMusicPlayback);
 
 	bool wasProgressLoaded = false;
+	g_runTelemetry.SetCollecting(true);
 
 	if (loadFile)
 	{
@@ -518,6 +827,7 @@ void Game::EnterGameplay(bool loadFile)
 		//seed rng
 		g_rng.SeedRNGWithTime();
 		g_rng.m_position = 0;
+		g_runTelemetry.BeginRun(g_rng.m_seed);
 
 		//create player and map
 		m_player = new Player();
@@ -529,6 +839,15 @@ void Game::EnterGameplay(bool loadFile)
 }
 
 
+void Game::EndTelemetryRun(bool isVictory) const
+{
+	//every run this session is rewritten, so the file is complete whenever the game is closed
+	int encountersCleared = isVictory ? m_map->m_currentEncounterNumber + 1 : m_map->m_currentEncounterNumber;
+	g_runTelemetry.EndRun(isVictory, encountersCleared);
+	g_runTelemetry.WriteColumns(TELEMETRY_FILE_PATH);
+}
+
+
 //
 //asset management functions
 //
@@ -575,6 +894,9 @@ void Game::LoadSounds()
 void Game::LoadTextures()
 {
 	g_playerSprite = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/Player_Ironclad.png");
+
+	//definition sprites come out of the atlas, so it has to be up before definitions load
+	g_spriteAtlas.Startup();
 }
 
 
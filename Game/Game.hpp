@@ -1,5 +1,10 @@
 #pragma once
 #include "Game/GameCommon.hpp"
+#include "Game/HitTestIndex.hpp"
+#include "Game/CombatTimeline.hpp"
+#include "Game/FloatingTextSystem.hpp"
+#include "Game/DefinitionReloader.hpp"
+#include "Game/RenderPrepWorker.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Input/Button.hpp"
@@ -8,6 +13,27 @@
 //forward declaration
 class Player;
 class Map;
+class Encounter;
+
+
+//constants
+constexpr float LOGIC_TICK_SECONDS = 1.0f / 60.0f;
+constexpr int MAX_LOGIC_TICKS_PER_FRAME = 120;			//a frame that falls further behind than this drops the rest instead of spiraling
+constexpr double FAST_FORWARD_BUDGET_SECONDS = 0.012;	//real time each frame spends ticking at PLAYBACK_RATE_UNCAPPED
+
+
+//what the hit-test index was last built for; clickable regions only move when one of these changes
+struct HitTestLayout
+{
+	Encounter const* m_encounter = nullptr;
+	int				 m_handSize = -1;
+	bool			 m_isRewardScreen = false;
+
+	bool operator==(HitTestLayout const& compare) const
+	{
+		return m_encounter == compare.m_encounter && m_handSize == compare.m_handSize && m_isRewardScreen == compare.m_isRewardScreen;
+	}
+};
 
 
 class Game 
@@ -21,7 +47,10 @@ public:
 	void Shutdown();
 
 	//game utilities
+	void PublishRenderSnapshot();
 	void BeginScreenShake(float screenShakeAmount);
+	void SetPlaybackRate(float playbackRate);
+	bool IsIdle() const;
 
 	//static functions
 	static bool Event_EndTurn(EventArgs& args);
@@ -32,6 +61,7 @@ public:
 	static bool Event_ReturnToGameplay(EventArgs& args);
 	static bool Event_SkipCard(EventArgs& args);
 	static bool Event_PlayerRest(EventArgs& args);
+	static bool Event_SetPlaybackRate(EventArgs& args);
 
 //public member variables
 public:
@@ -54,6 +84,21 @@ public:
 
 	//game clock
 	Clock m_gameClock = Clock();
+	float m_playbackRate = 1.0f;	//0 skips combat presentation, PLAYBACK_RATE_UNCAPPED fast-forwards
+
+	//logic advances in fixed ticks; game clock time not yet ticked carries over to the next frame
+	float m_logicAccumulatorSeconds = 0.0f;
+
+	//combat events pushed by gameplay, and the presentation of them once they've resolved
+	CombatEventQueue	m_combatEvents;
+	CombatTimeline		m_combatTimeline;
+	FloatingTextSystem	m_floatingText;
+
+	//builds vertexes from the snapshot published after each update while the main thread renders everything else
+	RenderPrepWorker m_renderPrepWorker;
+
+	//patches edited definition xml in while the game runs
+	DefinitionReloader m_definitionReloader;
 
 	//game actors
 	Player* m_player = nullptr;
@@ -64,10 +109,21 @@ private:
 	//game flow sub-functions
 	void UpdateAttract();
 	void RenderAttract() const;
+	void UpdateLogicTicks();
+	void UpdateLogicTick(float deltaSeconds);
+	void UpdateInput();
+	bool IsLogicStopped() const;
+	bool IsFastForwardable() const;
+	bool IsEncounterOver(Encounter const* currentEncounter) const;
+
+	//click dispatch functions
+	void DispatchClick(Encounter* currentEncounter);
+	void UpdateHitTestLayout(Encounter const* currentEncounter);
 
 	//mode-switching functions
 	void EnterAttractMode();
 	void EnterGameplay(bool loadFile);
+	void EndTelemetryRun(bool isVictory) const;
 
 	//asset management functions
 	void LoadAssets();
@@ -84,4 +140,8 @@ private:
 	float m_encounterEndTimer = 3.0f;
 	
 	bool m_loadedFile = false;
+
+	//clickable regions of the current encounter's layout
+	HitTestIndex  m_hitTestIndex = HitTestIndex(AABB2(0.0f, 0.0f, SCREEN_CAMERA_SIZE_X, SCREEN_CAMERA_SIZE_Y));
+	HitTestLayout m_hitTestLayout;
 };
@@ -10,7 +10,7 @@
 
 
 //global variables
-RandomNumberGenerator g_rng;
+thread_local RandomNumberGenerator g_rng;
 
 Texture* g_playerSprite = nullptr;
 BitmapFont* g_font = nullptr;
@@ -56,6 +56,7 @@ SoundID g_finalVictoryMusic;
 SoundPlaybackID g_finalVictoryMusicPlayback;
 
 
+#if !defined(GAME_HEADLESS)
 //
 //debug drawing functions
 //
@@ -136,3 +137,4 @@ void DebugDrawRing(Vec2 const& center, float radius, float width, Rgba8 const& c
 
 	g_theRenderer->DrawVertexArray(NUM_VERTEXES, verts);
 }
+#endif
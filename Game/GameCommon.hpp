@@ -21,7 +21,8 @@ extern InputSystem* g_theInput;
 extern AudioSystem* g_theAudio;
 extern Window* g_theWindow;
 
-extern RandomNumberGenerator g_rng;
+//game state globals are thread_local so the headless simulation can run one game per worker thread
+extern thread_local RandomNumberGenerator g_rng;
 
 extern Texture* g_playerSprite;
 extern BitmapFont* g_font;
@@ -0,0 +1,155 @@
+#include "Game/GameStateHasher.hpp"
+#include "Game/Game.hpp"
+#include "Game/Map.hpp"
+#include "Game/Player.hpp"
+#include "Game/Enemy.hpp"
+#include "Game/Encounter.hpp"
+#include "Game/CardDefinition.hpp"
+#include "Game/EffectDefinition.hpp"
+#include "Game/EnemyDefinition.hpp"
+#include "Game/EncounterDefinition.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+
+
+//
+//public static functions
+//
+uint64_t GameStateHasher::HashGame(Game const& game)
+{
+	GameStateHasher hasher;
+
+	hasher.AddInt(static_cast<int>(g_rng.m_seed));
+	hasher.AddInt(g_rng.m_position);
+	hasher.AddInt(game.m_isVictory ? 1 : 0);
+
+	Player const* player = game.m_player;
+	if (player != nullptr)
+	{
+		hasher.AddInt(player->m_currentHealth);
+		hasher.AddInt(player->m_maxHealth);
+		hasher.AddInt(player->m_currentEnergy);
+		hasher.AddInt(player->m_startEnergy);
+		hasher.AddInt(player->m_currentBlock);
+
+		hasher.AddInt(static_cast<int>(player->m_deck.size()));
+		for (int cardIndex = 0; cardIndex < player->m_deck.size(); cardIndex++)
+		{
+			hasher.AddCard(&player->m_deck[cardIndex]);
+		}
+		hasher.AddCardPile(player->m_drawPile);
+		hasher.AddCardPile(player->m_hand);
+		hasher.AddCardPile(player->m_discardPile);
+		hasher.AddEffects(player->m_effects);
+	}
+
+	Map const* map = game.m_map;
+	if (map != nullptr)
+	{
+		hasher.AddInt(map->m_currentEncounterNumber);
+		hasher.AddInt(map->m_isRestTime ? 1 : 0);
+
+		//earlier encounters have been deleted by the time the next one is entered, and nullptr slots are part of the state too
+		hasher.AddInt(static_cast<int>(map->m_allEncounters.size()));
+		for (int encounterIndex = 0; encounterIndex < map->m_allEncounters.size(); encounterIndex++)
+		{
+			hasher.AddEncounter(map->m_allEncounters[encounterIndex]);
+		}
+	}
+
+	return hasher.m_hash;
+}
+
+
+//
+//private hashing functions
+//
+void GameStateHasher::AddInt(int value)
+{
+	uint32_t bits = static_cast<uint32_t>(value);
+	for (int byteIndex = 0; byteIndex < 4; byteIndex++)
+	{
+		m_hash ^= static_cast<uint64_t>((bits >> (byteIndex * 8)) & 0xFF);
+		m_hash *= STATE_HASH_PRIME;
+	}
+}
+
+
+void GameStateHasher::AddCard(Card const* card)
+{
+	if (card == nullptr || card->m_definition == nullptr)
+	{
+		AddInt(-1);
+		return;
+	}
+
+	AddInt(static_cast<int>(card->m_definition->m_handle.GetIndex()));
+}
+
+
+void GameStateHasher::AddCardPile(std::vector<Card*> const& pile)
+{
+	AddInt(static_cast<int>(pile.size()));
+	for (int cardIndex = 0; cardIndex < pile.size(); cardIndex++)
+	{
+		AddCard(pile[cardIndex]);
+	}
+}
+
+
+void GameStateHasher::AddEffects(std::vector<Effect> const& effects)
+{
+	AddInt(static_cast<int>(effects.size()));
+	for (int effectIndex = 0; effectIndex < effects.size(); effectIndex++)
+	{
+		Effect const& effect = effects[effectIndex];
+		AddInt(static_cast<int>(effect.m_definition - EffectDefinition::s_effectDefs.data()));
+		AddInt(effect.m_stack);
+		AddInt(effect.m_justAdded ? 1 : 0);
+	}
+}
+
+
+void GameStateHasher::AddEnemy(Enemy const* enemy)
+{
+	if (enemy == nullptr)
+	{
+		AddInt(-1);
+		return;
+	}
+
+	AddInt(static_cast<int>(enemy->m_definition - EnemyDefinition::s_enemyDefs.data()));
+	AddInt(enemy->m_currentHealth);
+	AddInt(enemy->m_currentBlock);
+	AddInt(enemy->m_currentIntentionIndex);
+	AddEffects(enemy->m_effects);
+}
+
+
+void GameStateHasher::AddEncounter(Encounter const* encounter)
+{
+	if (encounter == nullptr)
+	{
+		AddInt(-1);
+		return;
+	}
+
+	AddInt(static_cast<int>(encounter->m_definition->m_handle.GetIndex()));
+	AddInt(encounter->m_encounterNumber);
+	AddInt(encounter->m_turnNumber);
+	AddInt(static_cast<int>(encounter->m_turnState));
+	AddInt(encounter->m_cardRewardScreenOpen ? 1 : 0);
+	if (encounter->m_cardRewardScreenOpen)
+	{
+		for (int rewardIndex = 0; rewardIndex < NUM_CARD_REWARDS; rewardIndex++)
+		{
+			AddCard(&encounter->m_cardRewards[rewardIndex]);
+		}
+	}
+
+	AddInt(static_cast<int>(encounter->m_currentEnemies.size()));
+	for (int enemyIndex = 0; enemyIndex < encounter->m_currentEnemies.size(); enemyIndex++)
+	{
+		AddEnemy(encounter->m_currentEnemies[enemyIndex]);
+	}
+}
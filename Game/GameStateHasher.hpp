@@ -0,0 +1,43 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include <cstdint>
+#include <vector>
+
+
+//forward declarations
+class Game;
+class Card;
+class Effect;
+class Enemy;
+class Encounter;
+
+
+//constants
+constexpr uint64_t STATE_HASH_OFFSET_BASIS = 0xCBF29CE484222325ull;	//64-bit FNV-1a
+constexpr uint64_t STATE_HASH_PRIME = 0x100000001B3ull;
+
+
+//hashes every piece of rules state in a game: rng, player stats, every card pile in order, effects, the map and every
+//remaining encounter and enemy; presentation state (labels, timelines, layout) is left out
+//definitions are hashed by their registry index, never by address, so hashes compare across processes and machines
+class GameStateHasher
+{
+//public member functions
+public:
+	//static functions
+	static uint64_t HashGame(Game const& game);
+
+//private member functions
+private:
+	//hashing functions
+	void AddInt(int value);
+	void AddCard(Card const* card);
+	void AddCardPile(std::vector<Card*> const& pile);
+	void AddEffects(std::vector<Effect> const& effects);
+	void AddEnemy(Enemy const* enemy);
+	void AddEncounter(Encounter const* encounter);
+
+//private member variables
+private:
+	uint64_t m_hash = STATE_HASH_OFFSET_BASIS;
+};
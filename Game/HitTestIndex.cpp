@@ -0,0 +1,106 @@
+#include "Game/HitTestIndex.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+static int ClampCellCoord(int cellCoord, int numCells)
+{
+	if (cellCoord < 0)			return 0;
+	if (cellCoord >= numCells)	return numCells - 1;
+	return cellCoord;
+}
+
+
+//
+//constructor
+//
+HitTestIndex::HitTestIndex(AABB2 const& bounds)
+	: m_bounds(bounds)
+{
+	m_cellSize.x = (bounds.m_maxs.x - bounds.m_mins.x) / static_cast<float>(HIT_TEST_GRID_CELLS_X);
+	m_cellSize.y = (bounds.m_maxs.y - bounds.m_mins.y) / static_cast<float>(HIT_TEST_GRID_CELLS_Y);
+}
+
+
+//
+//public layout functions
+//
+void HitTestIndex::Clear()
+{
+	m_regions.clear();
+
+	for (int cellIndex = 0; cellIndex < HIT_TEST_GRID_CELLS_X * HIT_TEST_GRID_CELLS_Y; cellIndex++)
+	{
+		m_cellRegionIndexes[cellIndex].clear();
+	}
+}
+
+
+void HitTestIndex::AddRegion(AABB2 const& regionBounds, HitTargetType type, int index)
+{
+	int regionIndex = static_cast<int>(m_regions.size());
+
+	HitRegion region;
+	region.m_bounds = regionBounds;
+	region.m_target.m_type = type;
+	region.m_target.m_index = index;
+	m_regions.emplace_back(region);
+
+	//add the region to every cell it overlaps
+	int minCellX = ClampCellCoord(static_cast<int>((regionBounds.m_mins.x - m_bounds.m_mins.x) / m_cellSize.x), HIT_TEST_GRID_CELLS_X);
+	int minCellY = ClampCellCoord(static_cast<int>((regionBounds.m_mins.y - m_bounds.m_mins.y) / m_cellSize.y), HIT_TEST_GRID_CELLS_Y);
+	int maxCellX = ClampCellCoord(static_cast<int>((regionBounds.m_maxs.x - m_bounds.m_mins.x) / m_cellSize.x), HIT_TEST_GRID_CELLS_X);
+	int maxCellY = ClampCellCoord(static_cast<int>((regionBounds.m_maxs.y - m_bounds.m_mins.y) / m_cellSize.y), HIT_TEST_GRID_CELLS_Y);
+
+	for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+	{
+		for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+		{
+			m_cellRegionIndexes[cellY * HIT_TEST_GRID_CELLS_X + cellX].emplace_back(regionIndex);
+		}
+	}
+}
+
+
+//
+//public query functions
+//
+HitTarget HitTestIndex::QueryPoint(Vec2 const& point) const
+{
+	HitTarget hitTarget;
+
+	int cellIndex = GetCellIndexForPoint(point);
+	if (cellIndex < 0)
+	{
+		return hitTarget;
+	}
+
+	std::vector<int> const& cellRegionIndexes = m_cellRegionIndexes[cellIndex];
+	for (int listIndex = 0; listIndex < cellRegionIndexes.size(); listIndex++)
+	{
+		HitRegion const& region = m_regions[cellRegionIndexes[listIndex]];
+
+		if (region.m_target.m_type >= hitTarget.m_type && IsPointInsideAABB2D(point, region.m_bounds))
+		{
+			hitTarget = region.m_target;
+		}
+	}
+
+	return hitTarget;
+}
+
+
+//
+//private functions
+//
+int HitTestIndex::GetCellIndexForPoint(Vec2 const& point) const
+{
+	if (!IsPointInsideAABB2D(point, m_bounds))
+	{
+		return -1;
+	}
+
+	int cellX = ClampCellCoord(static_cast<int>((point.x - m_bounds.m_mins.x) / m_cellSize.x), HIT_TEST_GRID_CELLS_X);
+	int cellY = ClampCellCoord(static_cast<int>((point.y - m_bounds.m_mins.y) / m_cellSize.y), HIT_TEST_GRID_CELLS_Y);
+	return cellY * HIT_TEST_GRID_CELLS_X + cellX;
+}
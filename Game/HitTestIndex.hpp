@@ -0,0 +1,75 @@
+#pragma once
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include <vector>
+
+
+//constants
+constexpr int HIT_TEST_GRID_CELLS_X = 16;
+constexpr int HIT_TEST_GRID_CELLS_Y = 8;
+
+
+//what a clickable region belongs to; later entries win when regions overlap (buttons sit on top of everything)
+//between regions of the same type, the one registered last wins
+enum class HitTargetType
+{
+	NONE = -1,
+	PLAYING_FIELD,
+	ENEMY,
+	HAND_CARD,
+	REWARD_CARD,
+	BUTTON,
+	COUNT
+};
+
+
+//the region under a click: its type and the index of whatever it represents (hand slot, enemy slot, reward slot)
+struct HitTarget
+{
+	HitTargetType m_type = HitTargetType::NONE;
+	int			  m_index = -1;
+};
+
+
+//one resolved click, handed to whoever handles that type of target
+struct ClickEvent
+{
+	HitTarget m_target;
+	Vec2	  m_position;
+};
+
+
+//uniform grid over the screen camera holding the clickable rectangles of the current layout
+//regions are registered once when the layout changes; a click is then a single cell lookup
+class HitTestIndex
+{
+//public member functions
+public:
+	//constructor
+	explicit HitTestIndex(AABB2 const& bounds);
+
+	//layout functions
+	void Clear();
+	void AddRegion(AABB2 const& regionBounds, HitTargetType type, int index);
+
+	//query functions
+	HitTarget QueryPoint(Vec2 const& point) const;
+	int GetNumRegions() const { return static_cast<int>(m_regions.size()); }
+
+//private member functions
+private:
+	int GetCellIndexForPoint(Vec2 const& point) const;
+
+//private member variables
+private:
+	struct HitRegion
+	{
+		AABB2	  m_bounds;
+		HitTarget m_target;
+	};
+
+	AABB2 m_bounds;
+	Vec2 m_cellSize;
+	std::vector<HitRegion> m_regions;
+	std::vector<int> m_cellRegionIndexes[HIT_TEST_GRID_CELLS_X * HIT_TEST_GRID_CELLS_Y];
+};
@@ -0,0 +1,149 @@
+#include "Game/HudLabel.hpp"
+#include "Game/AllocationTracker.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+#include <stdio.h>
+
+
+//
+//constructors
+//
+HudLabel::HudLabel(std::string const& format, Vec2 const& position, float textHeight, Vec2 const& alignment, Rgba8 const& color)
+	: m_format(format)
+	, m_position(position)
+	, m_textHeight(textHeight)
+	, m_alignment(alignment)
+	, m_color(color)
+{
+}
+
+
+//
+//public label setters
+//
+void HudLabel::BindSources(int const* firstSource, int const* secondSource)
+{
+	m_sources[0] = firstSource;
+	m_sources[1] = secondSource;
+	m_isDirty = true;
+}
+
+
+void HudLabel::SetValues(int firstValue, int secondValue)
+{
+	if (m_values[0] != firstValue || m_values[1] != secondValue)
+	{
+		m_values[0] = firstValue;
+		m_values[1] = secondValue;
+		m_isDirty = true;
+	}
+}
+
+
+void HudLabel::SetFormat(char const* format)
+{
+	if (m_format != format)
+	{
+		m_format = format;
+		m_isDirty = true;
+	}
+}
+
+
+void HudLabel::SetText(std::string const& text)
+{
+	std::string format;
+	format.reserve(text.size());
+	for (int charIndex = 0; charIndex < text.size(); charIndex++)
+	{
+		if (text[charIndex] == '%')
+		{
+			format += '%';
+		}
+		format += text[charIndex];
+	}
+
+	SetFormat(format.c_str());
+}
+
+
+void HudLabel::SetPosition(Vec2 const& position)
+{
+	if (!(m_position == position))
+	{
+		m_position = position;
+		m_isDirty = true;
+	}
+}
+
+
+void HudLabel::SetColor(Rgba8 const& color)
+{
+	if (!(m_color == color))
+	{
+		m_color = color;
+		m_isDirty = true;
+	}
+}
+
+
+#if !defined(GAME_HEADLESS)
+//
+//public game flow functions
+//
+void HudLabel::Render() const
+{
+	for (int valueIndex = 0; valueIndex < HUD_LABEL_MAX_VALUES; valueIndex++)
+	{
+		if (m_sources[valueIndex] != nullptr && *m_sources[valueIndex] != m_values[valueIndex])
+		{
+			m_values[valueIndex] = *m_sources[valueIndex];
+			m_isDirty = true;
+		}
+	}
+
+	if (m_isDirty)
+	{
+		RebuildVerts();
+	}
+
+	if (m_textVerts.empty())
+	{
+		return;
+	}
+
+	g_theRenderer->BindTexture(&g_font->GetTexture());
+	g_theRenderer->DrawVertexArray(m_textVerts);
+}
+
+
+//
+//private game flow functions
+//
+void HudLabel::RebuildVerts() const
+{
+	ScopedAllocationTag allocationTag(AllocationTag::UI_TEXT);
+
+	m_isDirty = false;
+	m_textVerts.clear();	//keeps its capacity, so same-length text is rebuilt in place
+
+	char text[HUD_LABEL_MAX_LENGTH + 1];
+	snprintf(text, sizeof(text), m_format.c_str(), m_values[0], m_values[1]);
+
+	int numLines = 1;
+	for (int charIndex = 0; text[charIndex] != '\0'; charIndex++)
+	{
+		if (text[charIndex] == '\n')
+		{
+			numLines++;
+		}
+	}
+
+	//lay the text out in a box that puts its alignment point exactly on the label's position
+	Vec2 boxDimensions = Vec2(SCREEN_CAMERA_SIZE_X, m_textHeight * static_cast<float>(numLines));
+	Vec2 boxMins = Vec2(m_position.x - boxDimensions.x * m_alignment.x, m_position.y - boxDimensions.y * m_alignment.y);
+	AABB2 textBox = AABB2(boxMins, boxMins + boxDimensions);
+
+	g_font->AddVertsForTextInBox2D(m_textVerts, textBox, m_textHeight, text, m_color, 1.0f, m_alignment, TextBoxMode::OVERRUN);
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include <vector>
+#include <string>
+
+
+//constants
+constexpr int HUD_LABEL_MAX_VALUES = 2;
+constexpr int HUD_LABEL_MAX_LENGTH = 63;
+
+
+//a retained piece of HUD text made from a printf-style format and up to two integers
+//the integers either come from bound sources, which are read at render time, or are pushed in with SetValues
+//text and glyph vertices are only rebuilt when a value, the format, the color or the position actually changes,
+//so a HUD that isn't changing costs no formatting and no allocation
+class HudLabel
+{
+//public member functions
+public:
+	//constructors
+	HudLabel() {}
+	HudLabel(std::string const& format, Vec2 const& position, float textHeight, Vec2 const& alignment, Rgba8 const& color = Rgba8());
+
+	//label setters
+	void BindSources(int const* firstSource, int const* secondSource = nullptr);	//sources must outlive the label
+	void SetValues(int firstValue, int secondValue = 0);
+	void SetFormat(char const* format);	//compares before copying, so passing the same literal every frame is free
+	void SetText(std::string const& text);	//shown as is; for text from data files, which must never be read as a format
+	void SetPosition(Vec2 const& position);
+	void SetColor(Rgba8 const& color);
+
+	//game flow functions
+	void Render() const;
+
+//private member functions
+private:
+	void RebuildVerts() const;
+
+//private member variables
+private:
+	std::string m_format;
+	Vec2		m_position;
+	float		m_textHeight = 20.0f;
+	Vec2		m_alignment;
+	Rgba8		m_color;
+
+	int const*	m_sources[HUD_LABEL_MAX_VALUES] = {};
+	mutable int m_values[HUD_LABEL_MAX_VALUES] = {};
+
+	mutable bool					m_isDirty = true;
+	mutable std::vector<Vertex_PCU> m_textVerts;
+};
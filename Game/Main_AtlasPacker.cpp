@@ -0,0 +1,206 @@
+#include "Game/SpriteAtlas.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Image.hpp"
+#include <algorithm>
+#include <cstdio>
+
+
+//offline tool: packs every sprite the card, enemy and effect definitions reference into a few atlas pages,
+//and writes the pages plus the manifest SpriteAtlas reads at startup. Run it from Run/ after changing any definition sprite.
+
+
+//a definition sprite and where it was packed
+struct PackedSprite
+{
+	std::string m_sourceFilePath;
+	Image		m_image;
+	IntVec2		m_dimensions;
+	int			m_pageIndex = -1;
+	IntVec2		m_texelMins;	//bottom-left texel on the page, the same way up the engine loads images
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static void GatherSpritePaths(char const* definitionsFilePath, std::vector<std::string>& out_spritePaths)
+{
+	XmlDocument definitionsXml;
+	if (definitionsXml.LoadFile(definitionsFilePath) != tinyxml2::XML_SUCCESS || definitionsXml.RootElement() == nullptr)
+	{
+		printf("Failed to read %s\n", definitionsFilePath);
+		return;
+	}
+
+	XmlElement const* element = definitionsXml.RootElement()->FirstChildElement();
+	while (element != nullptr)
+	{
+		std::string spritePath = ParseXmlAttribute(*element, "sprite", "");
+		if (!spritePath.empty() && std::find(out_spritePaths.begin(), out_spritePaths.end(), spritePath) == out_spritePaths.end())
+		{
+			out_spritePaths.emplace_back(spritePath);
+		}
+
+		element = element->NextSiblingElement();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//shelf packing: tallest sprites first, left to right along a shelf, a new shelf above once a row is full, a new page once that is
+static int PackSprites(std::vector<PackedSprite>& sprites)
+{
+	std::sort(sprites.begin(), sprites.end(), [](PackedSprite const& a, PackedSprite const& b)
+		{
+			return a.m_dimensions.y > b.m_dimensions.y;
+		});
+
+	int pageIndex = 0;
+	int shelfX = 0;
+	int shelfY = 0;
+	int shelfHeight = 0;
+	for (int spriteIndex = 0; spriteIndex < sprites.size(); spriteIndex++)
+	{
+		PackedSprite& sprite = sprites[spriteIndex];
+		int paddedWidth = sprite.m_dimensions.x + SPRITE_ATLAS_PADDING * 2;
+		int paddedHeight = sprite.m_dimensions.y + SPRITE_ATLAS_PADDING * 2;
+		GUARANTEE_OR_DIE(paddedWidth <= SPRITE_ATLAS_PAGE_SIZE && paddedHeight <= SPRITE_ATLAS_PAGE_SIZE, Stringf("%s is too big for an atlas page", sprite.m_sourceFilePath.c_str()));
+
+		if (shelfX + paddedWidth > SPRITE_ATLAS_PAGE_SIZE)
+		{
+			shelfX = 0;
+			shelfY += shelfHeight;
+			shelfHeight = 0;
+		}
+		if (shelfY + paddedHeight > SPRITE_ATLAS_PAGE_SIZE)
+		{
+			pageIndex++;
+			shelfX = 0;
+			shelfY = 0;
+			shelfHeight = 0;
+		}
+
+		sprite.m_pageIndex = pageIndex;
+		sprite.m_texelMins = IntVec2(shelfX + SPRITE_ATLAS_PADDING, shelfY + SPRITE_ATLAS_PADDING);
+
+		shelfX += paddedWidth;
+		shelfHeight = paddedHeight > shelfHeight ? paddedHeight : shelfHeight;
+	}
+
+	return sprites.empty() ? 0 : pageIndex + 1;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//uncompressed 32-bit tga, bottom-left origin; the engine's image loader reads it like any other texture
+static void WritePage(std::vector<PackedSprite> const& sprites, int pageIndex)
+{
+	std::vector<uint8_t> pageTexels(SPRITE_ATLAS_PAGE_SIZE * SPRITE_ATLAS_PAGE_SIZE * 4, 0);
+
+	for (int spriteIndex = 0; spriteIndex < sprites.size(); spriteIndex++)
+	{
+		PackedSprite const& sprite = sprites[spriteIndex];
+		if (sprite.m_pageIndex != pageIndex)
+		{
+			continue;
+		}
+
+		//copy the sprite and stretch its edge texels out into the padding around it
+		for (int y = -SPRITE_ATLAS_PADDING; y < sprite.m_dimensions.y + SPRITE_ATLAS_PADDING; y++)
+		{
+			for (int x = -SPRITE_ATLAS_PADDING; x < sprite.m_dimensions.x + SPRITE_ATLAS_PADDING; x++)
+			{
+				int sourceX = x < 0 ? 0 : (x >= sprite.m_dimensions.x ? sprite.m_dimensions.x - 1 : x);
+				int sourceY = y < 0 ? 0 : (y >= sprite.m_dimensions.y ? sprite.m_dimensions.y - 1 : y);
+				Rgba8 texel = sprite.m_image.GetTexelColor(IntVec2(sourceX, sourceY));
+
+				int pageTexelIndex = (sprite.m_texelMins.y + y) * SPRITE_ATLAS_PAGE_SIZE + (sprite.m_texelMins.x + x);
+				pageTexels[pageTexelIndex * 4 + 0] = texel.b;
+				pageTexels[pageTexelIndex * 4 + 1] = texel.g;
+				pageTexels[pageTexelIndex * 4 + 2] = texel.r;
+				pageTexels[pageTexelIndex * 4 + 3] = texel.a;
+			}
+		}
+	}
+
+	std::vector<uint8_t> tgaBuffer =
+	{
+		0, 0, 2,						//no id, no color map, uncompressed true color
+		0, 0, 0, 0, 0,					//color map spec
+		0, 0, 0, 0,						//origin
+		static_cast<uint8_t>(SPRITE_ATLAS_PAGE_SIZE & 0xFF), static_cast<uint8_t>(SPRITE_ATLAS_PAGE_SIZE >> 8),
+		static_cast<uint8_t>(SPRITE_ATLAS_PAGE_SIZE & 0xFF), static_cast<uint8_t>(SPRITE_ATLAS_PAGE_SIZE >> 8),
+		32, 8							//bits per texel, 8 alpha bits with rows starting at the bottom
+	};
+	tgaBuffer.insert(tgaBuffer.end(), pageTexels.begin(), pageTexels.end());
+
+	FileWriteFromBuffer(tgaBuffer, Stringf(SPRITE_ATLAS_PAGE_FILE_FORMAT, pageIndex));
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void WriteManifest(std::vector<PackedSprite> const& sprites, int numPages)
+{
+	std::string manifest = "<SpriteAtlas>\n";
+	for (int pageIndex = 0; pageIndex < numPages; pageIndex++)
+	{
+		manifest += Stringf("\t<Page texture=\"%s\"/>\n", Stringf(SPRITE_ATLAS_PAGE_FILE_FORMAT, pageIndex).c_str());
+	}
+
+	float texelSize = 1.0f / static_cast<float>(SPRITE_ATLAS_PAGE_SIZE);
+	for (int spriteIndex = 0; spriteIndex < sprites.size(); spriteIndex++)
+	{
+		PackedSprite const& sprite = sprites[spriteIndex];
+		float minU = static_cast<float>(sprite.m_texelMins.x) * texelSize;
+		float minV = static_cast<float>(sprite.m_texelMins.y) * texelSize;
+		float maxU = static_cast<float>(sprite.m_texelMins.x + sprite.m_dimensions.x) * texelSize;
+		float maxV = static_cast<float>(sprite.m_texelMins.y + sprite.m_dimensions.y) * texelSize;
+		manifest += Stringf("\t<Sprite source=\"%s\" page=\"%i\" uvs=\"%.6f,%.6f,%.6f,%.6f\"/>\n", sprite.m_sourceFilePath.c_str(), sprite.m_pageIndex, minU, minV, maxU, maxV);
+	}
+	manifest += "</SpriteAtlas>\n";
+
+	std::vector<uint8_t> buffer(manifest.begin(), manifest.end());
+	FileWriteFromBuffer(buffer, SPRITE_ATLAS_FILE_PATH);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	UNUSED(argc);
+	UNUSED(argv);
+
+	std::vector<std::string> spritePaths;
+	GatherSpritePaths("Data/Definitions/CardDefinitions.xml", spritePaths);
+	GatherSpritePaths("Data/Definitions/EnemyDefinitions.xml", spritePaths);
+	GatherSpritePaths("Data/Definitions/EffectDefinitions.xml", spritePaths);
+
+	std::vector<PackedSprite> sprites;
+	sprites.reserve(spritePaths.size());
+	for (int pathIndex = 0; pathIndex < spritePaths.size(); pathIndex++)
+	{
+		if (!CheckForFile(spritePaths[pathIndex]))
+		{
+			printf("Skipping missing sprite %s\n", spritePaths[pathIndex].c_str());
+			continue;
+		}
+
+		PackedSprite sprite;
+		sprite.m_sourceFilePath = spritePaths[pathIndex];
+		sprite.m_image = Image(spritePaths[pathIndex].c_str());
+		sprite.m_dimensions = sprite.m_image.GetDimensions();
+		sprites.emplace_back(sprite);
+	}
+
+	int numPages = PackSprites(sprites);
+	for (int pageIndex = 0; pageIndex < numPages; pageIndex++)
+	{
+		WritePage(sprites, pageIndex);
+	}
+	WriteManifest(sprites, numPages);
+
+	printf("Packed %i sprites into %i page(s) of %ix%i, manifest written to %s\n", static_cast<int>(sprites.size()), numPages,
+		SPRITE_ATLAS_PAGE_SIZE, SPRITE_ATLAS_PAGE_SIZE, SPRITE_ATLAS_FILE_PATH);
+
+	return 0;
+}
@@ -0,0 +1,609 @@
+#include "Game/App.hpp"
+#include "Game/Game.hpp"
+#include "Game/Map.hpp"
+#include "Game/Player.hpp"
+#include "Game/Enemy.hpp"
+#include "Game/Encounter.hpp"
+#include "Game/SaveManager.hpp"
+#include "Game/CombatState.hpp"
+#include "Game/CardDefinition.hpp"
+#include "Game/EffectDefinition.hpp"
+#include "Game/EnemyDefinition.hpp"
+#include "Game/EncounterDefinition.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+
+
+//the benchmark build doesn't link App.cpp, so it owns the game global itself
+thread_local Game* g_theGame = nullptr;
+
+
+//constants
+constexpr unsigned int BENCHMARK_SEED = 12345;
+constexpr int BENCHMARK_CARD_PLAYS_PER_REP = 32;		//small enough that the combat event queue never fills mid-rep
+constexpr int BENCHMARK_EFFECT_RECEIVES_PER_REP = 16;
+constexpr int BENCHMARK_STATE_FORKS_PER_REP = 64;
+constexpr int BENCHMARK_ENEMY_HEALTH = 1000000;			//so nothing dies partway through a rep
+
+
+//command line options
+struct BenchmarkOptions
+{
+	int			m_numWarmupReps = 20;
+	int			m_numReps = 200;
+	std::string m_filter;
+	std::string m_outputFilePath = "BenchmarkResults.json";
+};
+
+
+//timings of one benchmark, per operation
+struct BenchmarkResult
+{
+	std::string m_name;
+	int			m_numReps = 0;
+	int			m_opsPerRep = 0;
+	double		m_minNanoseconds = 0.0;
+	double		m_medianNanoseconds = 0.0;
+	double		m_p99Nanoseconds = 0.0;
+	double		m_meanNanoseconds = 0.0;
+};
+
+
+//a game set up the way Simulation::Run sets one up, sitting at the start of its first encounter
+struct BenchmarkFixture
+{
+	Game*	   m_game = nullptr;
+	Player*	   m_player = nullptr;
+	Encounter* m_encounter = nullptr;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static void PrintUsage()
+{
+	printf("Usage: TakeDownTheTower_Benchmark [--warmup=N] [--reps=N] [--filter=TEXT] [--out=FILE]\n");
+	printf("  --warmup=N     untimed reps run before measuring (default 20)\n");
+	printf("  --reps=N       timed reps per benchmark (default 200)\n");
+	printf("  --filter=TEXT  only run benchmarks whose name contains TEXT\n");
+	printf("  --out=FILE     json file to write results to (default BenchmarkResults.json)\n");
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool ParseCommandLine(int argc, char** argv, BenchmarkOptions& options)
+{
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		std::string arg = argv[argIndex];
+		size_t equalsPos = arg.find('=');
+		std::string key = arg.substr(0, equalsPos);
+		std::string value = (equalsPos == std::string::npos) ? "" : arg.substr(equalsPos + 1);
+
+		if (key == "--warmup")
+		{
+			options.m_numWarmupReps = atoi(value.c_str());
+		}
+		else if (key == "--reps")
+		{
+			options.m_numReps = atoi(value.c_str());
+		}
+		else if (key == "--filter")
+		{
+			options.m_filter = value;
+		}
+		else if (key == "--out")
+		{
+			options.m_outputFilePath = value;
+		}
+		else
+		{
+			printf("Unknown option \"%s\"\n", arg.c_str());
+			return false;
+		}
+	}
+
+	return options.m_numWarmupReps >= 0 && options.m_numReps > 0 && !options.m_outputFilePath.empty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//setup runs before every rep and isn't timed, so each rep measures the operation from the same starting state
+static void RunBenchmark(BenchmarkOptions const& options, std::vector<BenchmarkResult>& results, std::string const& name, int opsPerRep,
+	std::function<void()> const& setup, std::function<void()> const& body)
+{
+	if (!options.m_filter.empty() && name.find(options.m_filter) == std::string::npos)
+	{
+		return;
+	}
+
+	for (int repIndex = 0; repIndex < options.m_numWarmupReps; repIndex++)
+	{
+		setup();
+		body();
+	}
+
+	std::vector<double> samples;
+	samples.reserve(options.m_numReps);
+	for (int repIndex = 0; repIndex < options.m_numReps; repIndex++)
+	{
+		setup();
+
+		double startTime = GetCurrentTimeSeconds();
+		body();
+		double elapsedSeconds = GetCurrentTimeSeconds() - startTime;
+
+		samples.emplace_back(elapsedSeconds * 1000000000.0 / static_cast<double>(opsPerRep));
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	BenchmarkResult result;
+	result.m_name = name;
+	result.m_numReps = options.m_numReps;
+	result.m_opsPerRep = opsPerRep;
+	result.m_minNanoseconds = samples[0];
+	result.m_medianNanoseconds = samples[samples.size() / 2];
+	result.m_p99Nanoseconds = samples[(samples.size() * 99) / 100];
+	for (int sampleIndex = 0; sampleIndex < samples.size(); sampleIndex++)
+	{
+		result.m_meanNanoseconds += samples[sampleIndex];
+	}
+	result.m_meanNanoseconds /= static_cast<double>(samples.size());
+
+	printf("%-32s median %12.1f ns   p99 %12.1f ns   min %12.1f ns\n", name.c_str(), result.m_medianNanoseconds, result.m_p99Nanoseconds, result.m_minNanoseconds);
+	results.emplace_back(result);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void CreateFixture(BenchmarkFixture& fixture)
+{
+	fixture.m_game = new Game();
+	g_theGame = fixture.m_game;
+
+	g_rng.SeedRNG(BENCHMARK_SEED);
+	g_rng.m_position = 0;
+
+	fixture.m_game->m_isAttractMode = false;
+	fixture.m_player = new Player();
+	fixture.m_game->m_player = fixture.m_player;
+	fixture.m_game->m_map = new Map(fixture.m_player);
+	fixture.m_game->m_map->EnterFirstEncounter();
+	fixture.m_encounter = fixture.m_game->m_map->m_allEncounters[0];
+	fixture.m_game->m_combatEvents.DropAll();
+}
+
+
+static void DestroyFixture(BenchmarkFixture& fixture)
+{
+	//mirrors Simulation::~Simulation
+	delete fixture.m_game->m_map;
+	fixture.m_player->ResetCards();
+	delete fixture.m_player;
+	delete fixture.m_game;
+	g_theGame = nullptr;
+
+	fixture = BenchmarkFixture();
+}
+
+
+static void ResetCombatants(BenchmarkFixture& fixture)
+{
+	fixture.m_game->m_combatEvents.DropAll();
+
+	fixture.m_player->m_currentHealth = PLAYER_MAX_HEALTH;
+	fixture.m_player->m_currentBlock = 0;
+	fixture.m_player->m_effects.clear();
+	fixture.m_player->m_effectTriggers.Clear();
+
+	for (int enemyIndex = 0; enemyIndex < fixture.m_encounter->m_currentEnemies.size(); enemyIndex++)
+	{
+		Enemy* enemy = fixture.m_encounter->m_currentEnemies[enemyIndex];
+		if (enemy != nullptr)
+		{
+			enemy->m_currentHealth = BENCHMARK_ENEMY_HEALTH;
+			enemy->m_currentBlock = 0;
+			enemy->m_effects.clear();
+			enemy->m_effectTriggers.Clear();
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//first card whose first damage op matches, so the benchmarks follow whatever the definitions currently contain
+static CardDefinition const* FindDamageCard(TargetMode targetMode, bool isMultiHit)
+{
+	for (int defIndex = 0; defIndex < CardDefinition::s_cardDefs.size(); defIndex++)
+	{
+		CardDefinition const& cardDef = CardDefinition::s_cardDefs[defIndex];
+		for (int opIndex = 0; opIndex < cardDef.m_ops.size(); opIndex++)
+		{
+			CardOp const& op = cardDef.m_ops[opIndex];
+			if (op.m_opCode != CardOpCode::DEAL)
+			{
+				continue;
+			}
+
+			if (op.m_targetMode == targetMode && (op.m_count > 1) == isMultiHit)
+			{
+				return &cardDef;
+			}
+			break;
+		}
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void RunDefinitionBenchmarks(BenchmarkOptions const& options, std::vector<BenchmarkResult>& results)
+{
+	//each registry is rebuilt from scratch every rep; the order matters because cards resolve effects, enemies resolve cards
+	//and effects, and encounters resolve enemies, all by pointer
+	RunBenchmark(options, results, "InitializeEffectDefs", 1,
+		[]() { EffectDefinition::s_effectDefs.clear(); },
+		[]() { EffectDefinition::InitializeEffectDefs(); });
+	RunBenchmark(options, results, "InitializeCardDefs", 1,
+		[]() { CardDefinition::s_cardDefs.clear(); },
+		[]() { CardDefinition::InitializeCardDefs(); });
+	RunBenchmark(options, results, "InitializeEnemyDefs", 1,
+		[]() { EnemyDefinition::s_enemyDefs.clear(); },
+		[]() { EnemyDefinition::InitializeEnemyDefs(); });
+	RunBenchmark(options, results, "InitializeEncounterDefs", 1,
+		[]() { EncounterDefinition::s_encounterDefs.clear(); },
+		[]() { EncounterDefinition::InitializeEncounterDefs(); });
+
+	//a filter can skip some of the above, and everything after needs every registry loaded
+	if (EffectDefinition::s_effectDefs.size() == 0)
+	{
+		EffectDefinition::InitializeEffectDefs();
+	}
+	if (CardDefinition::s_cardDefs.size() == 0)
+	{
+		CardDefinition::InitializeCardDefs();
+	}
+	if (EnemyDefinition::s_enemyDefs.size() == 0)
+	{
+		EnemyDefinition::InitializeEnemyDefs();
+	}
+	if (EncounterDefinition::s_encounterDefs.size() == 0)
+	{
+		EncounterDefinition::InitializeEncounterDefs();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void RunCardPlayBenchmarks(BenchmarkOptions const& options, std::vector<BenchmarkResult>& results, BenchmarkFixture& fixture)
+{
+	struct CardPlayCase
+	{
+		char const* m_name;
+		TargetMode	m_targetMode;
+		bool		m_isMultiHit;
+	};
+	CardPlayCase const cases[] =
+	{
+		{ "Card::Play single target", TargetMode::ONE, false },
+		{ "Card::Play all targets",	  TargetMode::ALL, false },
+		{ "Card::Play multi-hit",	  TargetMode::ONE, true },
+	};
+
+	Enemy* enemyTarget = nullptr;
+	for (int enemyIndex = 0; enemyIndex < fixture.m_encounter->m_currentEnemies.size() && enemyTarget == nullptr; enemyIndex++)
+	{
+		enemyTarget = fixture.m_encounter->m_currentEnemies[enemyIndex];
+	}
+
+	for (int caseIndex = 0; caseIndex < sizeof(cases) / sizeof(cases[0]); caseIndex++)
+	{
+		CardPlayCase const& playCase = cases[caseIndex];
+		CardDefinition const* cardDef = FindDamageCard(playCase.m_targetMode, playCase.m_isMultiHit);
+		if (cardDef == nullptr || enemyTarget == nullptr)
+		{
+			printf("%-32s skipped, no matching card or enemy\n", playCase.m_name);
+			continue;
+		}
+
+		Card card(cardDef, fixture.m_player);
+		RunBenchmark(options, results, playCase.m_name, BENCHMARK_CARD_PLAYS_PER_REP,
+			[&]() { ResetCombatants(fixture); },
+			[&]()
+			{
+				for (int playNum = 0; playNum < BENCHMARK_CARD_PLAYS_PER_REP; playNum++)
+				{
+					card.Play(enemyTarget, fixture.m_encounter);
+				}
+			});
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void RunPlayerBenchmarks(BenchmarkOptions const& options, std::vector<BenchmarkResult>& results, BenchmarkFixture& fixture)
+{
+	Player* player = fixture.m_player;
+
+	RunBenchmark(options, results, "Player::DrawCard", MAX_HAND_SIZE,
+		[=]()
+		{
+			player->ResetCards();
+			player->ShuffleDrawPileFromDeck();
+		},
+		[=]()
+		{
+			for (int drawNum = 0; drawNum < MAX_HAND_SIZE; drawNum++)
+			{
+				player->DrawCard();
+			}
+		});
+
+	RunBenchmark(options, results, "Player::ShuffleDrawPileFromDeck", 1,
+		[=]() { player->ResetCards(); },
+		[=]() { player->ShuffleDrawPileFromDeck(); });
+
+	RunBenchmark(options, results, "Player::ShuffleDrawPileFromDiscard", 1,
+		[=]()
+		{
+			player->ResetCards();
+			for (int cardIndex = 0; cardIndex < player->m_deck.size(); cardIndex++)
+			{
+				player->m_discardPile.emplace_back(&player->m_deck[cardIndex]);
+			}
+		},
+		[=]() { player->ShuffleDrawPileFromDiscardPile(); });
+
+	//every effect already applied, so each receive walks a full effect list before stacking
+	RunBenchmark(options, results, "Player::ReceiveEffect many effects", BENCHMARK_EFFECT_RECEIVES_PER_REP,
+		[&]()
+		{
+			ResetCombatants(fixture);
+			for (int defIndex = 0; defIndex < EffectDefinition::s_effectDefs.size(); defIndex++)
+			{
+				player->ReceiveEffect(&EffectDefinition::s_effectDefs[defIndex], 1);
+			}
+			fixture.m_game->m_combatEvents.DropAll();
+		},
+		[=]()
+		{
+			int numEffectDefs = static_cast<int>(EffectDefinition::s_effectDefs.size());
+			for (int receiveNum = 0; receiveNum < BENCHMARK_EFFECT_RECEIVES_PER_REP; receiveNum++)
+			{
+				player->ReceiveEffect(&EffectDefinition::s_effectDefs[receiveNum % numEffectDefs], 1);
+			}
+		});
+
+	player->ResetCards();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void RunEncounterBenchmarks(BenchmarkOptions const& options, std::vector<BenchmarkResult>& results, BenchmarkFixture& fixture)
+{
+	//everyone carrying every effect, so the end of turn tick has the most to do
+	RunBenchmark(options, results, "Encounter::EndEnemyTurn", 1,
+		[&]()
+		{
+			ResetCombatants(fixture);
+			for (int defIndex = 0; defIndex < EffectDefinition::s_effectDefs.size(); defIndex++)
+			{
+				EffectDefinition const* effectDef = &EffectDefinition::s_effectDefs[defIndex];
+				fixture.m_player->ReceiveEffect(effectDef, 2);
+				for (int enemyIndex = 0; enemyIndex < fixture.m_encounter->m_currentEnemies.size(); enemyIndex++)
+				{
+					Enemy* enemy = fixture.m_encounter->m_currentEnemies[enemyIndex];
+					if (enemy != nullptr)
+					{
+						enemy->ReceiveEffect(effectDef, 2);
+					}
+				}
+			}
+			fixture.m_game->m_combatEvents.DropAll();
+		},
+		[&]() { fixture.m_encounter->EndEnemyTurn(); });
+
+	ResetCombatants(fixture);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//a mid-fight state with a dealt hand and as many effects as a state holds, the shape a search would fork from
+static void RunCombatStateBenchmarks(BenchmarkOptions const& options, std::vector<BenchmarkResult>& results, BenchmarkFixture& fixture)
+{
+	Player* player = fixture.m_player;
+	Encounter* encounter = fixture.m_encounter;
+
+	ResetCombatants(fixture);
+	player->ResetCards();
+	player->ShuffleDrawPileFromDeck();
+	for (int drawNum = 0; drawNum < CARDS_DRAWN_PER_TURN; drawNum++)
+	{
+		player->DrawCard();
+	}
+
+	int numEffectDefs = static_cast<int>(EffectDefinition::s_effectDefs.size());
+	for (int defIndex = 0; defIndex < numEffectDefs && defIndex < COMBAT_STATE_MAX_EFFECTS; defIndex++)
+	{
+		EffectDefinition const* effectDef = &EffectDefinition::s_effectDefs[defIndex];
+		player->ReceiveEffect(effectDef, 2);
+		for (int enemyIndex = 0; enemyIndex < encounter->m_currentEnemies.size(); enemyIndex++)
+		{
+			Enemy* enemy = encounter->m_currentEnemies[enemyIndex];
+			if (enemy != nullptr)
+			{
+				enemy->ReceiveEffect(effectDef, 2);
+			}
+		}
+	}
+	fixture.m_game->m_combatEvents.DropAll();
+
+	CombatState state;
+	if (!state.Capture(*player, *encounter))
+	{
+		printf("%-32s skipped, the fixture doesn't fit in a CombatState\n", "CombatState");
+		ResetCombatants(fixture);
+		player->ResetCards();
+		return;
+	}
+
+	std::vector<CombatState> forks(BENCHMARK_STATE_FORKS_PER_REP);
+
+	RunBenchmark(options, results, "CombatState::Capture", BENCHMARK_STATE_FORKS_PER_REP,
+		[]() {},
+		[&]()
+		{
+			for (int forkIndex = 0; forkIndex < BENCHMARK_STATE_FORKS_PER_REP; forkIndex++)
+			{
+				forks[forkIndex].Capture(*player, *encounter);
+			}
+		});
+
+	RunBenchmark(options, results, "CombatState copy", BENCHMARK_STATE_FORKS_PER_REP,
+		[]() {},
+		[&]()
+		{
+			for (int forkIndex = 0; forkIndex < BENCHMARK_STATE_FORKS_PER_REP; forkIndex++)
+			{
+				forks[forkIndex] = state;
+			}
+		});
+
+	RunBenchmark(options, results, "CombatState::Restore", BENCHMARK_STATE_FORKS_PER_REP,
+		[]() {},
+		[&]()
+		{
+			for (int forkIndex = 0; forkIndex < BENCHMARK_STATE_FORKS_PER_REP; forkIndex++)
+			{
+				forks[forkIndex].Restore(*player, *encounter);
+			}
+		});
+
+	ResetCombatants(fixture);
+	player->ResetCards();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void RunMapAndSaveBenchmarks(BenchmarkOptions const& options, std::vector<BenchmarkResult>& results, BenchmarkFixture& fixture)
+{
+	RunBenchmark(options, results, "Map::Map", 1,
+		[]() {},
+		[&]()
+		{
+			Map* map = new Map(fixture.m_player);
+			delete map;
+		});
+
+	//saving writes Save.bin in the working directory, so whatever save was there is put back afterwards
+	std::vector<uint8_t> existingSave;
+	bool hadSave = CheckForFile("Save.bin");
+	if (hadSave)
+	{
+		FileReadToBuffer(existingSave, "Save.bin");
+	}
+
+	RunBenchmark(options, results, "SaveManager::SaveProgress", 1,
+		[]() { g_saveManager.RecordGameState(); },
+		[]() { g_saveManager.SaveProgress(); });
+
+	g_saveManager.RecordGameState();
+	g_saveManager.SaveProgress();
+
+	//loading builds a new player and map into g_theGame, so it gets a game of its own that's emptied before every rep
+	Game* loadGame = new Game();
+	g_theGame = loadGame;
+	auto clearLoadGame = [=]()
+		{
+			delete loadGame->m_map;
+			loadGame->m_map = nullptr;
+			if (loadGame->m_player != nullptr)
+			{
+				loadGame->m_player->ResetCards();
+				delete loadGame->m_player;
+				loadGame->m_player = nullptr;
+			}
+			loadGame->m_combatEvents.DropAll();
+		};
+
+	RunBenchmark(options, results, "SaveManager::LoadProgress", 1,
+		clearLoadGame,
+		[]() { g_saveManager.LoadProgress(); });
+
+	clearLoadGame();
+	delete loadGame;
+	g_theGame = fixture.m_game;
+
+	if (hadSave)
+	{
+		FileWriteFromBuffer(existingSave, "Save.bin");
+	}
+	else
+	{
+		std::error_code error;
+		std::filesystem::remove("Save.bin", error);
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void WriteResults(std::vector<BenchmarkResult> const& results, BenchmarkOptions const& options)
+{
+	std::string json = "{\n";
+	json += Stringf("\t\"seed\": %u,\n", BENCHMARK_SEED);
+	json += Stringf("\t\"warmupReps\": %i,\n", options.m_numWarmupReps);
+	json += Stringf("\t\"reps\": %i,\n", options.m_numReps);
+	json += "\t\"benchmarks\": [\n";
+	for (int resultIndex = 0; resultIndex < results.size(); resultIndex++)
+	{
+		BenchmarkResult const& result = results[resultIndex];
+		json += Stringf("\t\t{ \"name\": \"%s\", \"opsPerRep\": %i, \"minNs\": %.1f, \"medianNs\": %.1f, \"p99Ns\": %.1f, \"meanNs\": %.1f }%s\n",
+			result.m_name.c_str(), result.m_opsPerRep, result.m_minNanoseconds, result.m_medianNanoseconds, result.m_p99Nanoseconds,
+			result.m_meanNanoseconds, (resultIndex + 1 < results.size()) ? "," : "");
+	}
+	json += "\t]\n";
+	json += "}\n";
+
+	std::vector<uint8_t> buffer(json.begin(), json.end());
+	FileWriteFromBuffer(buffer, options.m_outputFilePath);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+	if (!ParseCommandLine(argc, argv, options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<BenchmarkResult> results;
+	RunDefinitionBenchmarks(options, results);
+
+	BenchmarkFixture fixture;
+	CreateFixture(fixture);
+
+	RunCardPlayBenchmarks(options, results, fixture);
+	RunPlayerBenchmarks(options, results, fixture);
+	RunEncounterBenchmarks(options, results, fixture);
+	RunCombatStateBenchmarks(options, results, fixture);
+	RunMapAndSaveBenchmarks(options, results, fixture);
+
+	DestroyFixture(fixture);
+
+	WriteResults(results, options);
+	printf("Ran %i benchmarks, results written to %s\n", static_cast<int>(results.size()), options.m_outputFilePath.c_str());
+
+	return 0;
+}
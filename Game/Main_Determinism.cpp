@@ -0,0 +1,348 @@
+#include "Game/App.hpp"
+#include "Game/Simulation.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+
+//the determinism harness doesn't link App.cpp, so it owns the game global itself
+thread_local Game* g_theGame = nullptr;
+
+
+//command line options
+struct DeterminismOptions
+{
+	unsigned int m_firstSeed = 1;
+	int			 m_numRuns = 1000;
+	int			 m_numThreads = 0;
+	std::string	 m_scriptFilePath;
+	std::string	 m_goldenFilePath = "GoldenHashes.txt";
+	bool		 m_isRecording = false;
+	bool		 m_isCheckingRoundTrips = false;
+};
+
+
+//every state hash one seed produced, or that the golden file says it should produce
+struct SeedHashes
+{
+	unsigned int		  m_seed = 0;
+	std::vector<uint64_t> m_stateHashes;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static void PrintUsage()
+{
+	printf("Usage: TakeDownTheTower_Determinism [--seed=N] [--runs=N] [--threads=N] [--script=FILE] [--golden=FILE] [--record] [--roundtrip]\n");
+	printf("  --seed=N       seed of the first run; run i uses seed N + i (default 1)\n");
+	printf("  --runs=N       number of seeds to run (default 1000)\n");
+	printf("  --threads=N    worker threads, 0 = one per hardware thread (default 0)\n");
+	printf("  --script=FILE  whitespace separated decisions to cycle through instead of the autoplayer\n");
+	printf("  --golden=FILE  golden hash file to check against or record to (default GoldenHashes.txt)\n");
+	printf("  --record       write the golden file from this build instead of checking against it\n");
+	printf("  --roundtrip    also fork every player turn, restore its captured combat state, and check the game hashes the same\n");
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool ParseCommandLine(int argc, char** argv, DeterminismOptions& options)
+{
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		std::string arg = argv[argIndex];
+		size_t equalsPos = arg.find('=');
+		std::string key = arg.substr(0, equalsPos);
+		std::string value = (equalsPos == std::string::npos) ? "" : arg.substr(equalsPos + 1);
+
+		if (key == "--seed")
+		{
+			options.m_firstSeed = static_cast<unsigned int>(strtoul(value.c_str(), nullptr, 10));
+		}
+		else if (key == "--runs")
+		{
+			options.m_numRuns = atoi(value.c_str());
+		}
+		else if (key == "--threads")
+		{
+			options.m_numThreads = atoi(value.c_str());
+		}
+		else if (key == "--script")
+		{
+			options.m_scriptFilePath = value;
+		}
+		else if (key == "--golden")
+		{
+			options.m_goldenFilePath = value;
+		}
+		else if (key == "--record")
+		{
+			options.m_isRecording = true;
+		}
+		else if (key == "--roundtrip")
+		{
+			options.m_isCheckingRoundTrips = true;
+		}
+		else
+		{
+			printf("Unknown option \"%s\"\n", arg.c_str());
+			return false;
+		}
+	}
+
+	if (options.m_numThreads <= 0)
+	{
+		options.m_numThreads = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	if (options.m_numThreads <= 0)
+	{
+		options.m_numThreads = 1;
+	}
+
+	return options.m_numRuns > 0 && !options.m_goldenFilePath.empty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool ReadDecisionScript(std::string const& filePath, std::vector<int>& out_decisions)
+{
+	std::string script;
+	if (FileReadToString(script, filePath) < 0)
+	{
+		return false;
+	}
+
+	char const* readPosition = script.c_str();
+	char* endPosition = nullptr;
+	for (long decision = strtol(readPosition, &endPosition, 10); endPosition != readPosition; decision = strtol(readPosition, &endPosition, 10))
+	{
+		out_decisions.emplace_back(static_cast<int>(decision));
+		readPosition = endPosition;
+	}
+
+	return !out_decisions.empty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//one line per seed: the seed, how many hashes follow, then every state hash in hex
+static void WriteGoldenFile(std::vector<SeedHashes> const& runs, std::string const& filePath)
+{
+	std::string golden;
+	for (int runIndex = 0; runIndex < runs.size(); runIndex++)
+	{
+		SeedHashes const& run = runs[runIndex];
+		golden += Stringf("%u %i", run.m_seed, static_cast<int>(run.m_stateHashes.size()));
+		for (int hashIndex = 0; hashIndex < run.m_stateHashes.size(); hashIndex++)
+		{
+			golden += Stringf(" %016llx", static_cast<unsigned long long>(run.m_stateHashes[hashIndex]));
+		}
+		golden += "\n";
+	}
+
+	std::vector<uint8_t> buffer(golden.begin(), golden.end());
+	FileWriteFromBuffer(buffer, filePath);
+}
+
+
+static bool ReadGoldenFile(std::string const& filePath, std::vector<SeedHashes>& out_runs)
+{
+	std::string golden;
+	if (FileReadToString(golden, filePath) < 0)
+	{
+		return false;
+	}
+
+	Strings lines = SplitStringOnDelimiter(golden, '\n');
+	for (int lineIndex = 0; lineIndex < lines.size(); lineIndex++)
+	{
+		char const* readPosition = lines[lineIndex].c_str();
+		char* endPosition = nullptr;
+
+		SeedHashes run;
+		run.m_seed = static_cast<unsigned int>(strtoul(readPosition, &endPosition, 10));
+		if (endPosition == readPosition)
+		{
+			continue;
+		}
+		readPosition = endPosition;
+
+		int numHashes = static_cast<int>(strtol(readPosition, &endPosition, 10));
+		readPosition = endPosition;
+
+		run.m_stateHashes.reserve(numHashes);
+		for (int hashIndex = 0; hashIndex < numHashes; hashIndex++)
+		{
+			run.m_stateHashes.emplace_back(static_cast<uint64_t>(strtoull(readPosition, &endPosition, 16)));
+			readPosition = endPosition;
+		}
+
+		out_runs.emplace_back(run);
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//returns the number of seeds that diverged, printing where each one first did
+static int CompareToGolden(std::vector<SeedHashes> const& runs, std::vector<SeedHashes> const& goldenRuns)
+{
+	int numMismatches = 0;
+	for (int runIndex = 0; runIndex < runs.size(); runIndex++)
+	{
+		SeedHashes const& run = runs[runIndex];
+
+		SeedHashes const* goldenRun = nullptr;
+		if (runIndex < goldenRuns.size() && goldenRuns[runIndex].m_seed == run.m_seed)
+		{
+			goldenRun = &goldenRuns[runIndex];
+		}
+		for (int goldenIndex = 0; goldenIndex < goldenRuns.size() && goldenRun == nullptr; goldenIndex++)
+		{
+			if (goldenRuns[goldenIndex].m_seed == run.m_seed)
+			{
+				goldenRun = &goldenRuns[goldenIndex];
+			}
+		}
+
+		if (goldenRun == nullptr)
+		{
+			printf("Seed %u: no golden hashes recorded\n", run.m_seed);
+			numMismatches++;
+			continue;
+		}
+
+		int numCommonHashes = static_cast<int>(run.m_stateHashes.size() < goldenRun->m_stateHashes.size() ? run.m_stateHashes.size() : goldenRun->m_stateHashes.size());
+		int firstMismatch = -1;
+		for (int hashIndex = 0; hashIndex < numCommonHashes && firstMismatch < 0; hashIndex++)
+		{
+			if (run.m_stateHashes[hashIndex] != goldenRun->m_stateHashes[hashIndex])
+			{
+				firstMismatch = hashIndex;
+			}
+		}
+		if (firstMismatch < 0 && run.m_stateHashes.size() != goldenRun->m_stateHashes.size())
+		{
+			firstMismatch = numCommonHashes;
+		}
+
+		if (firstMismatch >= 0)
+		{
+			printf("Seed %u: diverged at action %i of %i (golden has %i)\n", run.m_seed, firstMismatch,
+				static_cast<int>(run.m_stateHashes.size()), static_cast<int>(goldenRun->m_stateHashes.size()));
+			numMismatches++;
+		}
+	}
+
+	return numMismatches;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//returns the number of seeds with a fork whose restore didn't bring back the captured hash, printing each one
+static int ReportRoundTrips(std::vector<SeedHashes> const& runs, std::vector<RoundTripResult> const& roundTrips)
+{
+	RoundTripResult total;
+	int numMismatchedSeeds = 0;
+	for (int runIndex = 0; runIndex < roundTrips.size(); runIndex++)
+	{
+		RoundTripResult const& roundTrip = roundTrips[runIndex];
+		if (roundTrip.m_numMismatches > 0)
+		{
+			printf("Seed %u: %i of %i combat state round trips changed the game hash\n", runs[runIndex].m_seed, roundTrip.m_numMismatches, roundTrip.m_numForks);
+			numMismatchedSeeds++;
+		}
+
+		total.m_numForks += roundTrip.m_numForks;
+		total.m_numMismatches += roundTrip.m_numMismatches;
+		total.m_numForksAddingCards += roundTrip.m_numForksAddingCards;
+		total.m_numForksKillingEnemies += roundTrip.m_numForksKillingEnemies;
+		total.m_numForksChangingHand += roundTrip.m_numForksChangingHand;
+	}
+
+	//a check that never saw a card added or an enemy die hasn't covered the restore paths most likely to break
+	printf("Round tripped %i forks (%i added cards, %i killed enemies, %i changed the hand): %i changed the game hash\n", total.m_numForks,
+		total.m_numForksAddingCards, total.m_numForksKillingEnemies, total.m_numForksChangingHand, total.m_numMismatches);
+
+	return numMismatchedSeeds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	DeterminismOptions options;
+	if (!ParseCommandLine(argc, argv, options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<int> decisionScript;
+	if (!options.m_scriptFilePath.empty() && !ReadDecisionScript(options.m_scriptFilePath, decisionScript))
+	{
+		printf("Failed to read a decision script from %s\n", options.m_scriptFilePath.c_str());
+		return 1;
+	}
+
+	std::vector<SeedHashes> goldenRuns;
+	if (!options.m_isRecording && !ReadGoldenFile(options.m_goldenFilePath, goldenRuns))
+	{
+		printf("Failed to read %s; run with --record first\n", options.m_goldenFilePath.c_str());
+		return 1;
+	}
+
+	//definitions are shared, read-only data once loaded
+	Simulation::InitializeDefinitions();
+
+	std::vector<SeedHashes> runs(options.m_numRuns);
+	std::vector<RoundTripResult> roundTrips(options.m_numRuns);
+	std::atomic<int> nextRunIndex(0);
+
+	auto runWorker = [&]()
+	{
+		for (int runIndex = nextRunIndex++; runIndex < options.m_numRuns; runIndex = nextRunIndex++)
+		{
+			SeedHashes& run = runs[runIndex];
+			run.m_seed = options.m_firstSeed + static_cast<unsigned int>(runIndex);
+
+			Simulation simulation(run.m_seed);
+			simulation.SetDecisionScript(&decisionScript);
+			simulation.SetStateHashOutput(&run.m_stateHashes);
+			if (options.m_isCheckingRoundTrips)
+			{
+				simulation.SetRoundTripOutput(&roundTrips[runIndex]);
+			}
+			simulation.Run();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (int threadIndex = 0; threadIndex < options.m_numThreads; threadIndex++)
+	{
+		workers.emplace_back(runWorker);
+	}
+	for (int threadIndex = 0; threadIndex < workers.size(); threadIndex++)
+	{
+		workers[threadIndex].join();
+	}
+
+	int numRoundTripMismatches = options.m_isCheckingRoundTrips ? ReportRoundTrips(runs, roundTrips) : 0;
+
+	if (options.m_isRecording)
+	{
+		WriteGoldenFile(runs, options.m_goldenFilePath);
+		printf("Recorded golden hashes for %i seeds to %s\n", options.m_numRuns, options.m_goldenFilePath.c_str());
+		return (numRoundTripMismatches == 0) ? 0 : 2;
+	}
+
+	int numMismatches = CompareToGolden(runs, goldenRuns);
+	printf("Checked %i seeds on %i threads against %s: %i diverged\n", options.m_numRuns, options.m_numThreads,
+		options.m_goldenFilePath.c_str(), numMismatches);
+
+	return (numMismatches == 0 && numRoundTripMismatches == 0) ? 0 : 2;
+}
@@ -0,0 +1,176 @@
+#include "Game/App.hpp"
+#include "Game/Simulation.hpp"
+#include "Game/RunTelemetry.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+
+//the headless build doesn't link App.cpp, so it owns the game global itself
+thread_local Game* g_theGame = nullptr;
+
+
+//command line options
+struct HeadlessOptions
+{
+	unsigned int m_firstSeed = 1;
+	int			 m_numRuns = 1;
+	int			 m_numThreads = 1;
+	std::string	 m_outputFilePath = "SimulationResults.csv";
+	std::string	 m_telemetryFilePath;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static void PrintUsage()
+{
+	printf("Usage: TakeDownTheTower_Headless [--seed=N] [--runs=N] [--threads=N] [--out=FILE] [--telemetry=FILE]\n");
+	printf("  --seed=N     seed of the first run; run i uses seed N + i (default 1)\n");
+	printf("  --runs=N     number of full games to simulate (default 1)\n");
+	printf("  --threads=N  worker threads, 0 = one per hardware thread (default 1)\n");
+	printf("  --out=FILE   csv file to write one line per run to (default SimulationResults.csv)\n");
+	printf("  --telemetry=FILE  columnar telemetry file to write every run's gameplay counters to (default none)\n");
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool ParseCommandLine(int argc, char** argv, HeadlessOptions& options)
+{
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		std::string arg = argv[argIndex];
+		size_t equalsPos = arg.find('=');
+		std::string key = arg.substr(0, equalsPos);
+		std::string value = (equalsPos == std::string::npos) ? "" : arg.substr(equalsPos + 1);
+
+		if (key == "--seed")
+		{
+			options.m_firstSeed = static_cast<unsigned int>(strtoul(value.c_str(), nullptr, 10));
+		}
+		else if (key == "--runs")
+		{
+			options.m_numRuns = atoi(value.c_str());
+		}
+		else if (key == "--threads")
+		{
+			options.m_numThreads = atoi(value.c_str());
+		}
+		else if (key == "--out")
+		{
+			options.m_outputFilePath = value;
+		}
+		else if (key == "--telemetry")
+		{
+			options.m_telemetryFilePath = value;
+		}
+		else
+		{
+			printf("Unknown option \"%s\"\n", arg.c_str());
+			return false;
+		}
+	}
+
+	if (options.m_numThreads <= 0)
+	{
+		options.m_numThreads = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	if (options.m_numThreads <= 0)
+	{
+		options.m_numThreads = 1;
+	}
+
+	return options.m_numRuns > 0 && !options.m_outputFilePath.empty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void WriteResults(std::vector<SimulationResult> const& results, std::string const& filePath)
+{
+	std::string csv = "seed,victory,stalemate,encountersCleared,finalHealth,turns,cardsPlayed,deckSize,damageDealt,damageTaken\n";
+	for (int runIndex = 0; runIndex < results.size(); runIndex++)
+	{
+		SimulationResult const& result = results[runIndex];
+		csv += Stringf("%u,%i,%i,%i,%i,%i,%i,%i,%i,%i\n", result.m_seed, result.m_isVictory ? 1 : 0, result.m_isStalemate ? 1 : 0,
+			result.m_encountersCleared, result.m_finalHealth, result.m_totalTurns, result.m_cardsPlayed, result.m_finalDeckSize,
+			result.m_damageDealt, result.m_damageTaken);
+	}
+
+	std::vector<uint8_t> buffer(csv.begin(), csv.end());
+	FileWriteFromBuffer(buffer, filePath);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	HeadlessOptions options;
+	if (!ParseCommandLine(argc, argv, options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	//definitions are shared, read-only data once loaded
+	Simulation::InitializeDefinitions();
+
+	std::vector<SimulationResult> results(options.m_numRuns);
+	std::atomic<int> nextRunIndex(0);
+
+	//each worker collects telemetry in its own thread_local buffer and merges it once, when it runs out of work
+	RunTelemetry mergedTelemetry;
+	std::mutex mergedTelemetryMutex;
+	bool isCollectingTelemetry = !options.m_telemetryFilePath.empty();
+
+	auto runWorker = [&]()
+	{
+		g_runTelemetry.SetCollecting(isCollectingTelemetry);
+
+		for (int runIndex = nextRunIndex++; runIndex < options.m_numRuns; runIndex = nextRunIndex++)
+		{
+			Simulation simulation(options.m_firstSeed + static_cast<unsigned int>(runIndex));
+			results[runIndex] = simulation.Run();
+		}
+
+		if (isCollectingTelemetry)
+		{
+			std::lock_guard<std::mutex> lock(mergedTelemetryMutex);
+			mergedTelemetry.AppendRunsFrom(g_runTelemetry);
+			g_runTelemetry.ClearRuns();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (int threadIndex = 0; threadIndex < options.m_numThreads; threadIndex++)
+	{
+		workers.emplace_back(runWorker);
+	}
+	for (int threadIndex = 0; threadIndex < workers.size(); threadIndex++)
+	{
+		workers[threadIndex].join();
+	}
+
+	WriteResults(results, options.m_outputFilePath);
+	if (isCollectingTelemetry)
+	{
+		mergedTelemetry.WriteColumns(options.m_telemetryFilePath);
+	}
+
+	int numVictories = 0;
+	for (int runIndex = 0; runIndex < results.size(); runIndex++)
+	{
+		if (results[runIndex].m_isVictory)
+		{
+			numVictories++;
+		}
+	}
+
+	printf("Simulated %i runs on %i threads: %i victories (%.1f%%), results written to %s\n", options.m_numRuns, options.m_numThreads,
+		numVictories, 100.0f * static_cast<float>(numVictories) / static_cast<float>(options.m_numRuns), options.m_outputFilePath.c_str());
+
+	return 0;
+}
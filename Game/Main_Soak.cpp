@@ -0,0 +1,184 @@
+#include "Game/App.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/NullPlatform.hpp"
+#include "Game/AllocationTracker.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+
+//command line options
+struct SoakOptions
+{
+	int			m_numFrames = 10000;
+	std::string m_inputScriptFilePath;
+	bool		m_loopInputScript = false;
+	bool		m_printCounters = false;
+	bool		m_checkAllocationBudgets = false;
+	int			m_numAllocationWarmupFrames = 60;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static void PrintUsage()
+{
+	printf("Usage: TakeDownTheTower_Soak [--frames=N] [--input=FILE] [--loop-input] [--counters] [--allocation-budgets] [--allocation-warmup=N]\n");
+	printf("  --frames=N    number of App frames to run, uncapped (default 10000)\n");
+	printf("  --input=FILE  scripted input, one \"<frame> <key> [<x> <y>]\" per line\n");
+	printf("  --loop-input  restart the input script after its last frame\n");
+	printf("  --counters    count draw calls, vertices, binds and sounds and print them at the end\n");
+	printf("  --allocation-budgets   fail (exit code 3) if any frame goes over a GameConfig.xml allocationBudget<Tag>\n");
+	printf("  --allocation-warmup=N  frames not held to the allocation budgets while caches fill up (default 60)\n");
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static bool ParseCommandLine(int argc, char** argv, SoakOptions& options)
+{
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		std::string arg = argv[argIndex];
+		size_t equalsPos = arg.find('=');
+		std::string key = arg.substr(0, equalsPos);
+		std::string value = (equalsPos == std::string::npos) ? "" : arg.substr(equalsPos + 1);
+
+		if (key == "--frames")
+		{
+			options.m_numFrames = atoi(value.c_str());
+		}
+		else if (key == "--input")
+		{
+			options.m_inputScriptFilePath = value;
+		}
+		else if (key == "--loop-input")
+		{
+			options.m_loopInputScript = true;
+		}
+		else if (key == "--counters")
+		{
+			options.m_printCounters = true;
+		}
+		else if (key == "--allocation-budgets")
+		{
+			options.m_checkAllocationBudgets = true;
+		}
+		else if (key == "--allocation-warmup")
+		{
+			options.m_numAllocationWarmupFrames = atoi(value.c_str());
+		}
+		else
+		{
+			printf("Unknown option \"%s\"\n", arg.c_str());
+			return false;
+		}
+	}
+
+	return options.m_numFrames > 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	SoakOptions options;
+	if (!ParseCommandLine(argc, argv, options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	if (!options.m_inputScriptFilePath.empty() && !LoadScriptedInputFromFile(options.m_inputScriptFilePath, options.m_loopInputScript))
+	{
+		printf("Failed to load input script \"%s\"\n", options.m_inputScriptFilePath.c_str());
+		return 1;
+	}
+
+	EnableNullPlatformCounters(options.m_printCounters);
+
+	g_theApp = new App();
+	g_theApp->Startup();
+
+	//startup work (definition loading etc.) isn't part of the soak numbers
+	ResetNullPlatformCounters();
+
+	double totalFrameSeconds = 0.0;
+	double maxFrameSeconds = 0.0;
+	int numFramesRun = 0;
+	int numIdleFrames = 0;	//frames after which the windowed game would have slept until input
+
+	for (int frameIndex = 0; frameIndex < options.m_numFrames && !g_theApp->IsQuitting(); frameIndex++)
+	{
+		auto frameStart = std::chrono::steady_clock::now();
+		g_theApp->RunFrame();
+		auto frameEnd = std::chrono::steady_clock::now();
+
+		double frameSeconds = std::chrono::duration<double>(frameEnd - frameStart).count();
+		totalFrameSeconds += frameSeconds;
+		if (frameSeconds > maxFrameSeconds)
+		{
+			maxFrameSeconds = frameSeconds;
+		}
+		numFramesRun++;
+		if (g_theApp->IsIdle())
+		{
+			numIdleFrames++;
+		}
+
+		//startup's allocations are closed out by the first frame, so they're always part of the warmup
+		if (numFramesRun == options.m_numAllocationWarmupFrames || (numFramesRun == 1 && options.m_numAllocationWarmupFrames <= 1))
+		{
+			ResetAllocationBudgetOverruns();
+		}
+	}
+
+	//the last frame's allocations are only checked when the next frame would begin
+	BeginAllocationFrame();
+
+	g_theApp->Shutdown();
+	delete g_theApp;
+	g_theApp = nullptr;
+
+	double averageFrameMs = numFramesRun > 0 ? 1000.0 * totalFrameSeconds / static_cast<double>(numFramesRun) : 0.0;
+	printf("Ran %i frames in %.3fs: average %.4fms, max %.4fms per frame\n", numFramesRun, totalFrameSeconds, averageFrameMs, 1000.0 * maxFrameSeconds);
+
+	if (options.m_printCounters)
+	{
+		NullPlatformCounters const& counters = GetNullPlatformCounters();
+		double framesDivisor = numFramesRun > 0 ? static_cast<double>(numFramesRun) : 1.0;
+		printf("  draw calls      %10llu (%.1f per frame)\n", (unsigned long long)counters.m_drawCalls, static_cast<double>(counters.m_drawCalls) / framesDivisor);
+		printf("  vertices drawn  %10llu (%.1f per frame)\n", (unsigned long long)counters.m_verticesDrawn, static_cast<double>(counters.m_verticesDrawn) / framesDivisor);
+		printf("  texture binds   %10llu\n", (unsigned long long)counters.m_textureBinds);
+		printf("  shader binds    %10llu\n", (unsigned long long)counters.m_shaderBinds);
+		printf("  camera begins   %10llu\n", (unsigned long long)counters.m_cameraBegins);
+		printf("  screen clears   %10llu\n", (unsigned long long)counters.m_screenClears);
+		printf("  sounds started  %10llu\n", (unsigned long long)counters.m_soundsStarted);
+		printf("  sounds stopped  %10llu\n", (unsigned long long)counters.m_soundsStopped);
+		printf("  keys pressed    %10llu\n", (unsigned long long)counters.m_keysPressed);
+		printf("  idle frames     %10i\n", numIdleFrames);
+	}
+
+	if (options.m_checkAllocationBudgets)
+	{
+		int numOverruns = 0;
+		for (int tagIndex = 0; tagIndex < static_cast<int>(AllocationTag::COUNT); tagIndex++)
+		{
+			AllocationTag tag = static_cast<AllocationTag>(tagIndex);
+			if (GetAllocationBudget(tag) < 0)
+			{
+				continue;
+			}
+
+			int numTagOverruns = GetNumAllocationBudgetOverruns(tag);
+			printf("  %-8s budget %4i allocations per frame, over in %i frames\n", GetAllocationTagName(tag), GetAllocationBudget(tag), numTagOverruns);
+			numOverruns += numTagOverruns;
+		}
+
+		if (numOverruns > 0)
+		{
+			printf("Allocation budgets exceeded\n");
+			return 3;
+		}
+	}
+
+	return 0;
+}
@@ -4,6 +4,15 @@
 #include <windows.h>			// #include this (massive, platform-specific) header in very few places
 
 
+//-----------------------------------------------------------------------------------------------
+//sleeps until a window message (input, focus, paint) is waiting or the time runs out; input already queued returns at once
+static void WaitForWindowMessages(double maxWaitSeconds)
+{
+	DWORD maxWaitMilliseconds = static_cast<DWORD>(maxWaitSeconds * 1000.0);
+	MsgWaitForMultipleObjectsEx(0, nullptr, maxWaitMilliseconds, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+}
+
+
 //-----------------------------------------------------------------------------------------------
 int WINAPI WinMain( HINSTANCE , HINSTANCE, LPSTR commandLineString, int )
 {
@@ -11,6 +20,7 @@ int WINAPI WinMain( HINSTANCE , HINSTANCE, LPSTR commandLineString, int )
 
 	g_theApp = new App();
 	g_theApp->Startup();
+	g_theApp->SetIdleWaitFunction(WaitForWindowMessages);
 
 	g_theApp->Run();
 
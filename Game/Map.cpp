@@ -6,6 +6,7 @@
 #include "Game/Player.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/SaveManager.hpp"
+#include "Game/FrameAllocator.hpp"
 #include "ThirdParty/Squirrel/SmoothNoise.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
@@ -20,6 +21,8 @@
 //
 Map::Map(Player* player)
 {
+	m_restHealthLabel.BindSources(&player->m_currentHealth, &player->m_maxHealth);
+
 	//initialize all encounters
 	for (int encounterIndex = 0; encounterIndex < NUM_ENCOUNTERS_DIFFICULTY_0; encounterIndex++)
 	{
@@ -64,6 +67,9 @@ Map::Map(Player* player)
 	//put secret final boss encounter here
 	EncounterDefinition const* finalBossEncounter = EncounterDefinition::GetEncounterDefinition(static_cast<int>(EncounterDefinition::s_encounterDefs.size()) - 1);
 	m_allEncounters.emplace_back(new Encounter(finalBossEncounter, ENCOUNTER_DIFFICULTY_2_MAX_INDEX + 1, player, this));
+
+	//saves and telemetry size themselves by this constant before any map exists
+	GUARANTEE_OR_DIE(m_allEncounters.size() == NUM_MAP_ENCOUNTERS, "Map built a different number of encounters than NUM_MAP_ENCOUNTERS!");
 }
 
 
@@ -79,6 +85,7 @@ Map::~Map()
 }
 
 
+#if !defined(GAME_HEADLESS)
 //
 //public game flow functions
 //
@@ -90,7 +97,8 @@ void Map::UpdateRestStop()
 void Map::RenderRestStop() const
 {
 	//add flickering background
-	std::vector<Vertex_PCU> backgroundVerts;
+	FrameVerts backgroundVerts;
+	backgroundVerts.reserve(6);
 	AABB2 screenBounds = AABB2(0.0f, 0.0f, SCREEN_CAMERA_SIZE_X, SCREEN_CAMERA_SIZE_Y);
 
 	float fireFlicker = Compute1dPerlinNoise(g_theGame->m_gameClock.GetTotalSeconds(), 1.0f, 3, 0.5f, 2.0f, true);
@@ -110,13 +118,12 @@ void Map::RenderRestStop() const
 	backgroundVerts.push_back(Vertex_PCU(Vec2(screenBounds.m_mins.x, screenBounds.m_maxs.y), Rgba8(fireColor.r, fireColor.g, fireColor.b, 0)));
 
 	g_theRenderer->BindTexture(nullptr);
-	g_theRenderer->DrawVertexArray(backgroundVerts);
+	DrawFrameVerts(backgroundVerts);
 	
-	DebugAddScreenText("Take a breather...", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_SIZE_Y - 25.0f), 50.0f, Vec2(0.5f, 1.0f), 0.0f);
-
-	std::string healthText = Stringf("HP: %i/%i", g_theGame->m_player->m_currentHealth, PLAYER_MAX_HEALTH);
-	DebugAddScreenText(healthText, Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_CENTER_Y), 50.0f, Vec2(0.5f, 0.0f), 0.0f, Rgba8(255, 0, 0), Rgba8(255, 0, 0));
+	m_restTitleLabel.Render();
+	m_restHealthLabel.Render();
 }
+#endif
 
 
 //public map utilities
@@ -134,9 +141,11 @@ void Map::EnterNextEncounter()
 		return;
 	}
 
+#if !defined(GAME_HEADLESS)
 	g_theAudio->StopSound(g_restStopMusicPlayback);
 	g_theAudio->StopSound(g_finalRestStopMusicPlayback);
 	g_theAudio->StopSound(g_campfireSoundPlayback);
+#endif
 	
 	if (m_currentEncounterNumber < m_allEncounters.size() - 1)
 	{
@@ -146,6 +155,7 @@ void Map::EnterNextEncounter()
 		m_currentEncounterNumber++;
 		m_isRestTime = false;
 		m_allEncounters[m_currentEncounterNumber]->BeginEncounter();
+#if !defined(GAME_HEADLESS)
 		if (m_currentEncounterNumber == NUM_ENCOUNTERS_DIFFICULTY_0)
 		{
 			g_battle2MusicPlayback = g_theAudio->StartSound(g_battle2Music, true, 0.8f);
@@ -162,6 +172,7 @@ void Map::EnterNextEncounter()
 		{
 			g_finalBossMusicPlayback = g_theAudio->StartSound(g_finalBossMusic, true);
 		}
+#endif
 	}
 	else
 	{
@@ -176,6 +187,7 @@ void Map::EnterRestStop()
 
 	g_saveManager.RecordGameState();
 
+#if !defined(GAME_HEADLESS)
 	g_theAudio->StopSound(g_battleMusicPlayback);
 	g_theAudio->StopSound(g_battle2MusicPlayback);
 	g_theAudio->StopSound(g_battle3MusicPlayback);
@@ -189,4 +201,5 @@ void Map::EnterRestStop()
 		g_restStopMusicPlayback = g_theAudio->StartSound(g_restStopMusic, true);
 	}
 	g_campfireSoundPlayback = g_theAudio->StartSound(g_campfireSound, true);
+#endif
 }
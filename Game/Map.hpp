@@ -1,5 +1,6 @@
 #pragma once
 #include "Game/Encounter.hpp"
+#include "Game/HudLabel.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
 
@@ -14,6 +15,7 @@ constexpr int NUM_ENCOUNTERS_DIFFICULTY_2 = 3;
 
 constexpr int ENCOUNTER_DIFFICULTY_1_MAX_INDEX = NUM_ENCOUNTERS_DIFFICULTY_0 + NUM_ENCOUNTERS_DIFFICULTY_1;
 constexpr int ENCOUNTER_DIFFICULTY_2_MAX_INDEX = ENCOUNTER_DIFFICULTY_1_MAX_INDEX + NUM_ENCOUNTERS_DIFFICULTY_2;
+constexpr int NUM_MAP_ENCOUNTERS = ENCOUNTER_DIFFICULTY_2_MAX_INDEX + 2;	//the boss and the secret final boss follow the hard encounters
 
 
 class Map
@@ -39,4 +41,8 @@ public:
 	int m_currentEncounterNumber = 0;
 
 	bool m_isRestTime = false;
+
+	//hud labels
+	HudLabel m_restTitleLabel = HudLabel("Take a breather...", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_SIZE_Y - 25.0f), 50.0f, Vec2(0.5f, 1.0f));
+	HudLabel m_restHealthLabel = HudLabel("HP: %i/%i", Vec2(SCREEN_CAMERA_CENTER_X, SCREEN_CAMERA_CENTER_Y), 50.0f, Vec2(0.5f, 0.0f), Rgba8(255, 0, 0));
 };
@@ -0,0 +1,502 @@
+#include "Game/NullPlatform.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Window/Window.hpp"
+#include "Engine/Input/InputSystem.hpp"
+#include "Engine/Audio/AudioSystem.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <map>
+
+
+//null platform state lives here rather than in the Engine classes, whose layouts belong to the real implementations
+static bool s_countersEnabled = false;
+static NullPlatformCounters s_counters;
+
+static std::map<std::string, Texture*> s_loadedTextures;
+static std::map<std::string, BitmapFont*> s_loadedFonts;
+
+static std::vector<ScriptedInputEvent> s_scriptedInput;
+static bool s_loopScriptedInput = false;
+static int s_scriptLength = 0;
+static int s_nextScriptedInputIndex = 0;
+static int s_inputFrameNumber = -1;
+static bool s_keysJustPressed[256] = {};
+static Vec2 s_cursorNormalizedPosition = Vec2(0.5f, 0.5f);
+
+static std::map<std::string, SoundID> s_loadedSounds;
+static SoundID s_nextSoundID = 0;
+static SoundPlaybackID s_nextSoundPlaybackID = 0;
+
+
+#define COUNT_NULL_PLATFORM_CALL(counterName, amount) if (s_countersEnabled) { s_counters.counterName += (amount); }
+
+
+//
+//counters
+//
+void EnableNullPlatformCounters(bool enabled)
+{
+	s_countersEnabled = enabled;
+}
+
+
+NullPlatformCounters const& GetNullPlatformCounters()
+{
+	return s_counters;
+}
+
+
+void ResetNullPlatformCounters()
+{
+	s_counters = NullPlatformCounters();
+}
+
+
+//
+//scripted input
+//
+static bool ParseScriptedKeyName(std::string const& keyName, unsigned char& out_keyCode, bool& out_isCursorMoveOnly)
+{
+	out_isCursorMoveOnly = false;
+
+	if (keyName == "LMB")			 out_keyCode = KEYCODE_LMB;
+	else if (keyName == "ESC")		 out_keyCode = KEYCODE_ESC;
+	else if (keyName == "SHIFT")	 out_keyCode = KEYCODE_SHIFT;
+	else if (keyName == "F8")		 out_keyCode = KEYCODE_F8;
+	else if (keyName == "MOVE")		 out_isCursorMoveOnly = true;
+	else if (keyName.size() == 1)	 out_keyCode = static_cast<unsigned char>(toupper(keyName[0]));
+	else							 return false;
+
+	return true;
+}
+
+
+bool LoadScriptedInputFromFile(std::string const& filePath, bool loopScript)
+{
+	//one event per line: "<frame> <key> [<cursorX> <cursorY>]", key is LMB, ESC, SHIFT, F8, MOVE or a single character
+	//cursor coordinates are normalized, blank lines and lines starting with # are ignored
+	std::vector<uint8_t> fileBuffer;
+	FileReadToBuffer(fileBuffer, filePath);
+	if (fileBuffer.size() == 0)
+	{
+		return false;
+	}
+
+	std::string fileText(fileBuffer.begin(), fileBuffer.end());
+	std::vector<ScriptedInputEvent> inputEvents;
+
+	size_t lineStart = 0;
+	int lineNumber = 0;
+	while (lineStart < fileText.size())
+	{
+		size_t lineEnd = fileText.find('\n', lineStart);
+		if (lineEnd == std::string::npos)
+		{
+			lineEnd = fileText.size();
+		}
+
+		std::string line = fileText.substr(lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 1;
+		lineNumber++;
+
+		if (line.empty() || line[0] == '#' || line[0] == '\r')
+		{
+			continue;
+		}
+
+		int frameNumber = 0;
+		char keyName[32] = {};
+		float cursorX = 0.0f;
+		float cursorY = 0.0f;
+		int numParsed = sscanf(line.c_str(), "%d %31s %f %f", &frameNumber, keyName, &cursorX, &cursorY);
+
+		ScriptedInputEvent inputEvent;
+		bool isCursorMoveOnly = false;
+		if (numParsed < 2 || !ParseScriptedKeyName(keyName, inputEvent.m_keyCode, isCursorMoveOnly))
+		{
+			ERROR_RECOVERABLE(Stringf("Bad scripted input on line %i of %s", lineNumber, filePath.c_str()));
+			return false;
+		}
+
+		inputEvent.m_frameNumber = frameNumber;
+		inputEvent.m_movesCursor = isCursorMoveOnly || numParsed == 4;
+		inputEvent.m_cursorNormalizedPosition = Vec2(cursorX, cursorY);
+		inputEvents.emplace_back(inputEvent);
+	}
+
+	SetScriptedInput(inputEvents, loopScript);
+	return true;
+}
+
+
+void SetScriptedInput(std::vector<ScriptedInputEvent> const& inputEvents, bool loopScript)
+{
+	s_scriptedInput = inputEvents;
+	std::stable_sort(s_scriptedInput.begin(), s_scriptedInput.end(), [](ScriptedInputEvent const& a, ScriptedInputEvent const& b)
+	{
+		return a.m_frameNumber < b.m_frameNumber;
+	});
+
+	s_loopScriptedInput = loopScript;
+	s_scriptLength = s_scriptedInput.empty() ? 0 : s_scriptedInput.back().m_frameNumber + 1;
+	s_nextScriptedInputIndex = 0;
+	s_inputFrameNumber = -1;
+}
+
+
+static void ApplyScriptedInputForFrame(int frameNumber)
+{
+	if (s_scriptLength == 0)
+	{
+		return;
+	}
+
+	int scriptFrame = frameNumber;
+	if (s_loopScriptedInput)
+	{
+		scriptFrame = frameNumber % s_scriptLength;
+		if (scriptFrame == 0)
+		{
+			s_nextScriptedInputIndex = 0;
+		}
+	}
+
+	while (s_nextScriptedInputIndex < s_scriptedInput.size() && s_scriptedInput[s_nextScriptedInputIndex].m_frameNumber == scriptFrame)
+	{
+		ScriptedInputEvent const& inputEvent = s_scriptedInput[s_nextScriptedInputIndex];
+		if (inputEvent.m_movesCursor)
+		{
+			s_cursorNormalizedPosition = inputEvent.m_cursorNormalizedPosition;
+		}
+		if (inputEvent.m_keyCode != 0)
+		{
+			s_keysJustPressed[inputEvent.m_keyCode] = true;
+			COUNT_NULL_PLATFORM_CALL(m_keysPressed, 1);
+		}
+
+		s_nextScriptedInputIndex++;
+	}
+}
+
+
+//
+//null renderer
+//
+Renderer::Renderer(RendererConfig const& config)
+	: m_config(config)
+{
+}
+
+
+void Renderer::Startup()
+{
+}
+
+
+void Renderer::BeginFrame()
+{
+	COUNT_NULL_PLATFORM_CALL(m_framesBegun, 1);
+}
+
+
+void Renderer::EndFrame()
+{
+}
+
+
+void Renderer::Shutdown()
+{
+	for (auto& loadedFont : s_loadedFonts)
+	{
+		delete loadedFont.second;
+	}
+	s_loadedFonts.clear();
+
+	for (auto& loadedTexture : s_loadedTextures)
+	{
+		delete loadedTexture.second;
+	}
+	s_loadedTextures.clear();
+}
+
+
+void Renderer::ClearScreen(Rgba8 const& clearColor)
+{
+	UNUSED(clearColor);
+	COUNT_NULL_PLATFORM_CALL(m_screenClears, 1);
+}
+
+
+void Renderer::BeginCamera(Camera const& camera)
+{
+	UNUSED(camera);
+	COUNT_NULL_PLATFORM_CALL(m_cameraBegins, 1);
+}
+
+
+void Renderer::EndCamera(Camera const& camera)
+{
+	UNUSED(camera);
+}
+
+
+void Renderer::DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes)
+{
+	UNUSED(vertexes);
+	COUNT_NULL_PLATFORM_CALL(m_drawCalls, 1);
+	COUNT_NULL_PLATFORM_CALL(m_verticesDrawn, static_cast<uint64_t>(numVertexes));
+}
+
+
+void Renderer::DrawVertexArray(std::vector<Vertex_PCU> const& vertexes)
+{
+	DrawVertexArray(static_cast<int>(vertexes.size()), vertexes.data());
+}
+
+
+void Renderer::BindTexture(Texture const* texture)
+{
+	UNUSED(texture);
+	COUNT_NULL_PLATFORM_CALL(m_textureBinds, 1);
+}
+
+
+void Renderer::BindShader(Shader* shader)
+{
+	UNUSED(shader);
+	COUNT_NULL_PLATFORM_CALL(m_shaderBinds, 1);
+}
+
+
+void Renderer::SetBlendMode(BlendMode blendMode)
+{
+	UNUSED(blendMode);
+}
+
+
+void Renderer::SetSamplerMode(SamplerMode samplerMode)
+{
+	UNUSED(samplerMode);
+}
+
+
+void Renderer::SetRasterizerMode(RasterizerMode rasterizerMode)
+{
+	UNUSED(rasterizerMode);
+}
+
+
+void Renderer::SetDepthMode(DepthMode depthMode)
+{
+	UNUSED(depthMode);
+}
+
+
+void Renderer::SetModelConstants(Mat44 const& modelMatrix, Rgba8 const& modelColor)
+{
+	UNUSED(modelMatrix);
+	UNUSED(modelColor);
+}
+
+
+Texture* Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
+{
+	//one image-less texture per path, so pointer identity (and batching by texture) behaves like the real renderer
+	Texture*& texture = s_loadedTextures[imageFilePath];
+	if (texture == nullptr)
+	{
+		texture = new Texture();
+		texture->m_name = imageFilePath;
+	}
+
+	return texture;
+}
+
+
+BitmapFont* Renderer::CreateOrGetBitmapFont(char const* bitmapFontFilePathWithNoExtension)
+{
+	//fonts are real, so glyph vertex generation costs the same as in the windowed build
+	BitmapFont*& font = s_loadedFonts[bitmapFontFilePathWithNoExtension];
+	if (font == nullptr)
+	{
+		std::string textureFilePath = Stringf("%s.png", bitmapFontFilePathWithNoExtension);
+		Texture* fontTexture = CreateOrGetTextureFromFile(textureFilePath.c_str());
+		font = new BitmapFont(bitmapFontFilePathWithNoExtension, *fontTexture);
+	}
+
+	return font;
+}
+
+
+//
+//null window
+//
+Window::Window(WindowConfig const& config)
+	: m_config(config)
+{
+}
+
+
+void Window::Startup()
+{
+}
+
+
+void Window::BeginFrame()
+{
+}
+
+
+void Window::EndFrame()
+{
+}
+
+
+void Window::Shutdown()
+{
+}
+
+
+//
+//null (scripted) input
+//
+InputSystem::InputSystem(InputSystemConfig const& config)
+	: m_config(config)
+{
+}
+
+
+void InputSystem::Startup()
+{
+}
+
+
+void InputSystem::Shutdown()
+{
+}
+
+
+void InputSystem::BeginFrame()
+{
+	s_inputFrameNumber++;
+	ApplyScriptedInputForFrame(s_inputFrameNumber);
+}
+
+
+void InputSystem::EndFrame()
+{
+	//scripted keys are tapped: down for exactly one frame
+	for (int keyIndex = 0; keyIndex < 256; keyIndex++)
+	{
+		s_keysJustPressed[keyIndex] = false;
+	}
+}
+
+
+bool InputSystem::WasKeyJustPressed(unsigned char keyCode)
+{
+	return s_keysJustPressed[keyCode];
+}
+
+
+bool InputSystem::WasKeyJustReleased(unsigned char keyCode)
+{
+	UNUSED(keyCode);
+	return false;
+}
+
+
+bool InputSystem::IsKeyDown(unsigned char keyCode)
+{
+	return s_keysJustPressed[keyCode];
+}
+
+
+void InputSystem::HandleKeyPressed(unsigned char keyCode)
+{
+	s_keysJustPressed[keyCode] = true;
+}
+
+
+void InputSystem::HandleKeyReleased(unsigned char keyCode)
+{
+	UNUSED(keyCode);
+}
+
+
+Vec2 InputSystem::GetCursorNormalizedPosition() const
+{
+	return s_cursorNormalizedPosition;
+}
+
+
+//
+//null audio
+//
+AudioSystem::AudioSystem(AudioSystemConfig const& config)
+	: m_config(config)
+{
+}
+
+
+void AudioSystem::Startup()
+{
+}
+
+
+void AudioSystem::Shutdown()
+{
+	s_loadedSounds.clear();
+}
+
+
+void AudioSystem::BeginFrame()
+{
+}
+
+
+void AudioSystem::EndFrame()
+{
+}
+
+
+SoundID AudioSystem::CreateOrGetSound(std::string const& soundFilePath)
+{
+	//one id per path, like the real audio system, so callers comparing ids or creating the same sound twice see the same thing
+	std::map<std::string, SoundID>::const_iterator loadedSound = s_loadedSounds.find(soundFilePath);
+	if (loadedSound != s_loadedSounds.end())
+	{
+		return loadedSound->second;
+	}
+
+	SoundID soundID = s_nextSoundID++;
+	s_loadedSounds[soundFilePath] = soundID;
+	return soundID;
+}
+
+
+SoundPlaybackID AudioSystem::StartSound(SoundID soundID, bool isLooped, float volume, float balance, float speed, bool isPaused)
+{
+	UNUSED(soundID);
+	UNUSED(isLooped);
+	UNUSED(volume);
+	UNUSED(balance);
+	UNUSED(speed);
+	UNUSED(isPaused);
+	COUNT_NULL_PLATFORM_CALL(m_soundsStarted, 1);
+
+	return s_nextSoundPlaybackID++;
+}
+
+
+void AudioSystem::StopSound(SoundPlaybackID soundPlaybackID)
+{
+	UNUSED(soundPlaybackID);
+	COUNT_NULL_PLATFORM_CALL(m_soundsStopped, 1);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// NullPlatform.hpp
+//
+// Null Renderer, Window, InputSystem and AudioSystem for the soak build (GAME_NULL_PLATFORM).
+//	NullPlatform.cpp defines the Engine's platform classes' member functions in place of the
+//	Engine's D3D11 / Win32 / fmod implementations, so App::Startup builds the usual g_theRenderer,
+//	g_theWindow, g_theInput and g_theAudio and the whole App::RunFrame loop runs unchanged.
+//	Every call is accepted and does (almost) nothing; input comes from a script instead of a window.
+//
+
+
+//counts of what the game asked the platform to do; only touched when counters are enabled
+struct NullPlatformCounters
+{
+	uint64_t m_framesBegun = 0;
+	uint64_t m_drawCalls = 0;
+	uint64_t m_verticesDrawn = 0;
+	uint64_t m_textureBinds = 0;
+	uint64_t m_shaderBinds = 0;
+	uint64_t m_cameraBegins = 0;
+	uint64_t m_screenClears = 0;
+	uint64_t m_soundsStarted = 0;
+	uint64_t m_soundsStopped = 0;
+	uint64_t m_keysPressed = 0;
+};
+
+
+//one scripted input: on the given frame, press (and release next frame) a key, optionally moving the cursor first
+struct ScriptedInputEvent
+{
+	int			  m_frameNumber = 0;
+	unsigned char m_keyCode = 0;
+	bool		  m_movesCursor = false;
+	Vec2		  m_cursorNormalizedPosition = Vec2(0.5f, 0.5f);
+};
+
+
+//counters
+void EnableNullPlatformCounters(bool enabled);
+NullPlatformCounters const& GetNullPlatformCounters();
+void ResetNullPlatformCounters();
+
+//scripted input
+bool LoadScriptedInputFromFile(std::string const& filePath, bool loopScript);
+void SetScriptedInput(std::vector<ScriptedInputEvent> const& inputEvents, bool loopScript);
@@ -4,9 +4,13 @@
 #include "Game/GameCommon.hpp"
 #include "Game/App.hpp"
 #include "Game/Game.hpp"
+#include "Game/SpriteAtlas.hpp"
+#include "Game/AllocationTracker.hpp"
 #include "Game/Map.hpp"
+#include "Game/RunTelemetry.hpp"
 #include "Game/CardDefinition.hpp"
 #include "Game/EffectDefinition.hpp"
+#include "Game/FrameAllocator.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Core/VertexUtils.hpp"
@@ -22,77 +26,79 @@
 Player::Player()
 {
 	InitializeDeck();
+
+	m_healthLabel.BindSources(&m_currentHealth, &m_maxHealth);
+	m_blockLabel.BindSources(&m_currentBlock);
+	m_energyLabel.BindSources(&m_currentEnergy, &m_startEnergy);
 }
 
 
+#if !defined(GAME_HEADLESS)
 //
 //public game flow functions
 //
-void Player::Update()
+void Player::Update(float deltaSeconds)
 {
 	//lerp back from flashing red when hit
 	if (m_renderColor.r < 255)
 	{
-		m_renderColor.r = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.r) + 360.0f * g_theGame->m_gameClock.GetDeltaSeconds(), 0.0f, 255.0f));
+		m_renderColor.r = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.r) + 360.0f * deltaSeconds, 0.0f, 255.0f));
 	}
 	if (m_renderColor.g < 255)
 	{
-		m_renderColor.g = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.g) + 360.0f * g_theGame->m_gameClock.GetDeltaSeconds(), 0.0f, 255.0f));
+		m_renderColor.g = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.g) + 360.0f * deltaSeconds, 0.0f, 255.0f));
 	}
 	if (m_renderColor.b < 255)
 	{
-		m_renderColor.b = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.b) + 360.0f * g_theGame->m_gameClock.GetDeltaSeconds(), 0.0f, 255.0f));
-	}
-	
-	//check for mouse inputs for playing cards
-	for (int cardIndex = 0; cardIndex < m_hand.size(); cardIndex++)
-	{
-		bool wasCardPlayed = false;
-		m_hand[cardIndex]->Update(cardIndex, wasCardPlayed);
-
-		if (wasCardPlayed)
-		{
-			//no need to check other cards if one was played
-			break;
-		}
+		m_renderColor.b = static_cast<unsigned char>(GetClamped(static_cast<float>(m_renderColor.b) + 360.0f * deltaSeconds, 0.0f, 255.0f));
 	}
 }
 
 
 void Player::Render() const
 {
-	std::vector<Vertex_PCU> playerVerts;
-
-	AddVertsForAABB2(playerVerts, m_playerBounds, m_renderColor);
+	//the sprite only changes while it's flashing from a hit
+	if (m_spriteLayer.IsDirty() || !(m_spriteLayerColor == m_renderColor))
+	{
+		m_spriteLayerColor = m_renderColor;
+		std::vector<Vertex_PCU>& playerVerts = m_spriteLayer.BeginRebuild(g_playerSprite);
+		AddVertsForAABB2(playerVerts, m_playerBounds, m_renderColor);
+	}
 
 	g_theRenderer->BindShader(nullptr);
-	g_theRenderer->BindTexture(g_playerSprite);
-	g_theRenderer->DrawVertexArray(playerVerts);
+	m_spriteLayer.Render();
 
-	std::string healthText = Stringf("HP: %i/%i", m_currentHealth, PLAYER_MAX_HEALTH);
-	DebugAddScreenText(healthText, Vec2(375.0f, 350.0f), 25.0f, Vec2(0.5f, 1.0f), 0.0f, Rgba8(255, 0, 0), Rgba8(255, 0, 0));
-	std::string blockText = Stringf("Block: %i", m_currentBlock);
-	DebugAddScreenText(blockText, Vec2(375.0f, 325.0f), 25.0f, Vec2(0.5f, 1.0f), 0.0f, Rgba8(0, 100, 255), Rgba8(0, 100, 255));
-	std::string energyText = Stringf("Energy:\n%i/%i", m_currentEnergy, PLAYER_START_ENERGY);
-	DebugAddScreenText(energyText, Vec2(175.0f, 200.0f), 25.0f, Vec2(0.5f, 1.0f), 0.0f, Rgba8(255, 150, 0), Rgba8(255, 150, 0));
+	m_healthLabel.Render();
+	m_blockLabel.Render();
+	m_energyLabel.Render();
 
 	//render effect icons
+	if (m_effectStackLabels.size() < m_effects.size())
+	{
+		m_effectStackLabels.resize(m_effects.size(), HudLabel("%i", Vec2(), 20.0f, Vec2(0.0f, 1.0f)));
+	}
+
+	//icons share atlas pages, so they all go out in one batch per page before any of the stack counts
+	SpriteBatch iconBatch;
+	float iconMinY = m_playerBounds.m_mins.y - 90.0f;
 	for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
 	{
 		Effect const& effect = m_effects[effectIndex];
-		
-		float minX = 250.0f + static_cast<float>(40 * effectIndex);
-		float minY = m_playerBounds.m_mins.y - 90.0f;
-		AABB2 iconBounds = AABB2(minX, minY, minX + 40.0f, minY + 40.0f);
 
-		std::vector<Vertex_PCU> iconVerts;
-		AddVertsForAABB2(iconVerts, iconBounds);
+		float minX = 250.0f + static_cast<float>(40 * effectIndex);
+		AABB2 iconBounds = AABB2(minX, iconMinY, minX + 40.0f, iconMinY + 40.0f);
+		iconBatch.AddSprite(iconBounds, effect.m_definition->m_sprite, effect.m_definition->m_spriteUVs);
+	}
+	iconBatch.Flush();
 
-		g_theRenderer->BindTexture(effect.m_definition->m_sprite);
-		g_theRenderer->DrawVertexArray(iconVerts);
+	for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
+	{
+		float minX = 250.0f + static_cast<float>(40 * effectIndex);
 
-		std::string effectStackText = Stringf("%i", effect.m_stack);
-		DebugAddScreenText(effectStackText, Vec2(minX + 10.0f, minY), 20.0f, Vec2(0.0f, 1.0f), 0.0f);
+		HudLabel& stackLabel = m_effectStackLabels[effectIndex];
+		stackLabel.SetPosition(Vec2(minX + 10.0f, iconMinY));
+		stackLabel.SetValues(m_effects[effectIndex].m_stack);
+		stackLabel.Render();
 	}
 
 	//debug print effects
@@ -105,35 +111,181 @@ void Player::Render() const
 	}*/
 
 	//render cards
-	for (int handIndex = 0; handIndex < m_hand.size(); handIndex++)
-	{
-		m_hand[handIndex]->Render(handIndex);
-	}
-
-	//render draw and discard pile indicators
-	std::vector<Vertex_PCU> drawPileVerts;
-	AABB2 drawPileBox = AABB2(25.0f, 15.0f, 105.0f, 95.0f);
-	AddVertsForAABB2(drawPileVerts, drawPileBox, Rgba8(0, 0, 0));
-	g_theRenderer->BindTexture(nullptr);
-	g_theRenderer->DrawVertexArray(drawPileVerts);
-	std::string drawPileCount = Stringf("%i", m_drawPile.size());
-	DebugAddScreenText(drawPileCount, Vec2(65.0f, 55.0f), 35.0f, Vec2(0.5f, 0.5f), 0.0f);
-
-	std::vector<Vertex_PCU> discardPileVerts;
-	AABB2 discardPileBox = AABB2(SCREEN_CAMERA_SIZE_X - 105.0f, 15.0f, SCREEN_CAMERA_SIZE_X - 25.0f, 95.0f);
-	AddVertsForAABB2(discardPileVerts, discardPileBox, Rgba8(0, 0, 0));
-	g_theRenderer->BindTexture(nullptr);
-	g_theRenderer->DrawVertexArray(discardPileVerts);
-	std::string discardPileCount = Stringf("%i", m_discardPile.size());
-	DebugAddScreenText(discardPileCount, Vec2(SCREEN_CAMERA_SIZE_X - 65.0f, 55.0f), 35.0f, Vec2(0.5f, 0.5f), 0.0f);
+	//the new hand stays hidden while the enemy turn that came before it is still playing out
+	int handSize = g_theGame->m_combatTimeline.IsPlayingBeats() ? 0 : static_cast<int>(m_hand.size());
+	if (m_handLayout.IsHandOverlapping(handSize))
+	{
+		//overlapping cards have to be drawn whole, one after another, so each one covers the one before it
+		for (int handIndex = 0; handIndex < handSize; handIndex++)
+		{
+			m_hand[handIndex]->Render(m_handLayout.GetHandSlotBounds(handIndex, handSize));
+		}
+	}
+	else
+	{
+		//side by side, all the art can go first in one batch per atlas page, then the text over it
+		SpriteBatch artBatch;
+		for (int handIndex = 0; handIndex < handSize; handIndex++)
+		{
+			CardDefinition const* cardDef = m_hand[handIndex]->m_definition;
+			artBatch.AddSprite(m_handLayout.GetHandSlotBounds(handIndex, handSize), cardDef->m_sprite, cardDef->m_spriteUVs);
+		}
+		artBatch.Flush();
+
+		for (int handIndex = 0; handIndex < handSize; handIndex++)
+		{
+			m_hand[handIndex]->RenderDetails(m_handLayout.GetHandSlotBounds(handIndex, handSize));
+		}
+	}
+
+	//render draw and discard pile indicators; the boxes never move, so they're built once and drawn together
+	if (m_pileLayer.IsDirty())
+	{
+		std::vector<Vertex_PCU>& pileVerts = m_pileLayer.BeginRebuild(nullptr);
+		AABB2 drawPileBox = AABB2(25.0f, 15.0f, 105.0f, 95.0f);
+		AddVertsForAABB2(pileVerts, drawPileBox, Rgba8(0, 0, 0));
+		AABB2 discardPileBox = AABB2(SCREEN_CAMERA_SIZE_X - 105.0f, 15.0f, SCREEN_CAMERA_SIZE_X - 25.0f, 95.0f);
+		AddVertsForAABB2(pileVerts, discardPileBox, Rgba8(0, 0, 0));
+	}
+	m_pileLayer.Render();
+
+	m_drawPileLabel.SetValues(static_cast<int>(m_drawPile.size()));
+	m_drawPileLabel.Render();
+	m_discardPileLabel.SetValues(static_cast<int>(m_discardPile.size()));
+	m_discardPileLabel.Render();
 }
 
 
+//
+//public click handlers
+//
+void Player::OnHandCardClicked(int handIndex)
+{
+	if (handIndex >= m_hand.size())
+	{
+		return;
+	}
+
+	Card* clickedCard = m_hand[handIndex];
+	if (clickedCard != m_selectedCard)
+	{
+		m_selectedCard = clickedCard;
+		g_theAudio->StartSound(g_cardSound);
+	}
+	else
+	{
+		m_selectedCard = nullptr;
+	}
+}
+
+
+void Player::OnPlayingFieldClicked(Enemy* enemyUnderCursor)
+{
+	//clicking the playing field plays the selected card, or just deselects it if it can't be played there
+	if (m_selectedCard == nullptr)
+	{
+		return;
+	}
+
+	Card* cardToPlay = m_selectedCard;
+	m_selectedCard = nullptr;
+
+	if (!cardToPlay->m_definition->m_isPlayable)
+	{
+		return;
+	}
+
+	if (cardToPlay->m_definition->m_targetMode == TargetMode::ONE)
+	{
+		if (enemyUnderCursor != nullptr && enemyUnderCursor->m_currentHealth > 0)
+		{
+			PlayCard(cardToPlay, enemyUnderCursor);
+		}
+	}
+	else
+	{
+		PlayCard(cardToPlay, nullptr);
+	}
+}
+
+//
+//public presentation functions
+//
+void Player::PresentCombatEvent(CombatEvent const& event)
+{
+	switch (event.m_type)
+	{
+	case CombatEventType::HIT:
+	{
+		if (event.m_blockedAmount > 0)
+		{
+			g_theGame->m_floatingText.Spawn(FloatingTextStyle::BLOCKED_DAMAGE, event.m_blockedAmount, Vec2(250.0f, 325.0f));
+			g_theAudio->StartSound(g_damageBlockedSound);
+		}
+		if (event.m_amount > 0)
+		{
+			g_theGame->m_floatingText.Spawn(FloatingTextStyle::DAMAGE, event.m_amount, Vec2(250.0f, 350.0f));
+			g_theAudio->StartSound(g_damageSound);
+
+			m_renderColor.g = 0;
+			m_renderColor.b = 0;
+		}
+
+		g_theGame->BeginScreenShake(static_cast<float>(event.m_amount + event.m_blockedAmount));
+		break;
+	}
+	case CombatEventType::BLOCK:
+	{
+		g_theGame->m_floatingText.Spawn(FloatingTextStyle::BLOCK, event.m_amount, Vec2(250.0f, 325.0f));
+		g_theAudio->StartSound(g_blockSound);
+		break;
+	}
+	case CombatEventType::HEAL:
+	{
+		g_theGame->m_floatingText.Spawn(FloatingTextStyle::HEAL, event.m_amount, Vec2(250.0f, 350.0f));
+		g_theAudio->StartSound(g_healSound);
+
+		m_renderColor.r = 0;
+		m_renderColor.b = 0;
+		break;
+	}
+	case CombatEventType::EFFECT_APPLIED:
+	{
+		if (event.m_effect->m_type == EffectType::DEBUFF)
+		{
+			g_theAudio->StartSound(g_debuffSound);
+		}
+		else if (event.m_effect->m_type == EffectType::BUFF)
+		{
+			g_theAudio->StartSound(g_buffSound);
+		}
+		break;
+	}
+	case CombatEventType::DEBUFF_BLOCKED:
+	{
+		g_theGame->m_floatingText.Spawn(FloatingTextStyle::DEBUFF_BLOCKED, 0, Vec2(375.0f, 700.0f));
+		break;
+	}
+	case CombatEventType::CARD_ADDED:
+	{
+		std::string statusText = Stringf("Added %s to\ndraw pile", event.m_card->m_name.c_str());
+		DebugAddScreenText(statusText, Vec2(375.0f, 700.0f), 27.5f, Vec2(0.5f, 1.0f), 2.0f, Rgba8(255, 100, 0), Rgba8(255, 100, 0));
+		break;
+	}
+	default:
+		break;
+	}
+}
+#endif
+
+
 //
 //public player utilities
 //
 bool Player::PlayCard(Card* cardToPlay, Enemy* enemyTarget)
 {
+	ScopedAllocationTag allocationTag(AllocationTag::COMBAT);
+
 	//can't play card if you can't afford it
 	if (m_currentEnergy < cardToPlay->m_definition->m_cost)
 	{
@@ -162,6 +314,7 @@ bool Player::PlayCard(Card* cardToPlay, Enemy* enemyTarget)
 
 	//then actually cause card effects
 	cardToPlay->Play(enemyTarget, g_theGame->m_map->m_allEncounters[g_theGame->m_map->m_currentEncounterNumber]);
+	ApplyTriggeredEffects(EffectTrigger::CARD_PLAYED);
 
 	return true;
 }
@@ -173,9 +326,10 @@ void Player::GainBlock(int blockAmount)
 
 	if (blockAmount > 0)
 	{
-		std::string blockText = Stringf("+%i", blockAmount);
-		DebugAddScreenText(blockText, Vec2(250.0f, 325.0f), 30.0f, Vec2(1.0f, 1.0f), 2.0f, Rgba8(0, 100, 255), Rgba8(0, 100, 255));
-		g_theAudio->StartSound(g_blockSound);
+		CombatEvent event;
+		event.m_type = CombatEventType::BLOCK;
+		event.m_amount = blockAmount;
+		g_theGame->m_combatEvents.Push(event);
 	}
 }
 
@@ -186,12 +340,10 @@ void Player::RestoreHealth(int healthAmount)
 
 	if (healthAmount > 0)
 	{
-		std::string damageText = Stringf("+%i", healthAmount);
-		DebugAddScreenText(damageText, Vec2(250.0f, 350.0f), 30.0f, Vec2(1.0f, 1.0f), 2.0f, Rgba8(0, 255, 0), Rgba8(0, 255, 0));
-		g_theAudio->StartSound(g_healSound);
-
-		m_renderColor.r = 0;
-		m_renderColor.b = 0;
+		CombatEvent event;
+		event.m_type = CombatEventType::HEAL;
+		event.m_amount = healthAmount;
+		g_theGame->m_combatEvents.Push(event);
 	}
 }
 
@@ -218,67 +370,57 @@ void Player::TakeDamage(int damageAmount)
 	int finalDamageAmount = GetClamped(damageAmount - damageReduction, 0, damageAmount);
 
 	//then do damage to health
+	int startingHealth = m_currentHealth;
 	m_currentHealth = GetClamped(m_currentHealth - finalDamageAmount, 0, m_maxHealth);
 
-	if (damageReduction > 0)
+	//every source of damage (attacks, effect ticks, cards that cost health) lands here
+	if (g_theGame->m_map != nullptr)
 	{
-		std::string blockDamageText = Stringf("-%i", damageReduction);
-		DebugAddScreenText(blockDamageText, Vec2(250.0f, 325.0f), 30.0f, Vec2(1.0f, 1.0f), 2.0f, Rgba8(0, 100, 255), Rgba8(0, 100, 255));
-		g_theAudio->StartSound(g_damageBlockedSound);
+		g_runTelemetry.RecordEncounterHealthLost(g_theGame->m_map->m_currentEncounterNumber, startingHealth - m_currentHealth);
 	}
-	if (finalDamageAmount > 0)
-	{
-		std::string damageText = Stringf("-%i", finalDamageAmount);
-		DebugAddScreenText(damageText, Vec2(250.0f, 350.0f), 30.0f, Vec2(1.0f, 1.0f), 2.0f, Rgba8(255, 0, 0), Rgba8(255, 0, 0));
-		g_theAudio->StartSound(g_damageSound);
 
-		m_renderColor.g = 0;
-		m_renderColor.b = 0;
-	}
-
-	g_theGame->BeginScreenShake(static_cast<float>(damageAmount));
+	CombatEvent event;
+	event.m_type = CombatEventType::HIT;
+	event.m_amount = finalDamageAmount;
+	event.m_blockedAmount = damageReduction;
+	g_theGame->m_combatEvents.Push(event);
 }
 
 
 void Player::ReceiveEffect(EffectDefinition const* definition, int stack)
 {
-	//block debuffs with artifact
+	//block debuffs with anything that triggers on receiving one (artifact)
 	if (definition->m_type == EffectType::DEBUFF)
 	{
-		for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
+		std::vector<int> const& blockerIndices = m_effectTriggers.GetEffectIndices(EffectTrigger::DEBUFF_RECEIVED);
+		if (!blockerIndices.empty())
 		{
-			Effect& effect = m_effects[effectIndex];
+			int blockerIndex = blockerIndices[0];
+			m_effects[blockerIndex].m_stack -= 1;
 
-			if (effect.m_definition->m_blockDebuff)
+			CombatEvent event;
+			event.m_type = CombatEventType::DEBUFF_BLOCKED;
+			event.m_effect = definition;
+			g_theGame->m_combatEvents.Push(event);
+
+			if (m_effects[blockerIndex].m_stack <= 0)
 			{
-				effect.m_stack -= 1;
-				std::string artifactMessage = "Debuff Blocked";
-				DebugAddScreenText(artifactMessage, Vec2(375.0f, 700.0f), 27.5f, Vec2(0.5f, 1.0f), 2.0f, Rgba8(255, 100, 0), Rgba8(255, 100, 0));
-
-				if (effect.m_stack <= 0)
-				{
-					//use erase-remove idiom to remove effect
-					m_effects.erase(std::remove_if(
-						m_effects.begin(),
-						m_effects.end(),
-						[=](auto const& element)
-						{
-							return effect == element;
-						}),
-						m_effects.end()
-					);
-				}
-
-				return;
+				m_effects.erase(m_effects.begin() + blockerIndex);
+				m_effectTriggers.Rebuild(m_effects);
 			}
-		}
 
-		g_theAudio->StartSound(g_debuffSound);
-	}
-	else if (definition->m_type == EffectType::BUFF)
-	{
-		g_theAudio->StartSound(g_buffSound);
+			return;
+		}
 	}
+
+	//counted per target that actually takes the effect, so blocked debuffs and missed targets aren't
+	g_runTelemetry.RecordEffectApplied(definition);
+
+	CombatEvent event;
+	event.m_type = CombatEventType::EFFECT_APPLIED;
+	event.m_amount = stack;
+	event.m_effect = definition;
+	g_theGame->m_combatEvents.Push(event);
 	
 	bool newEffect = true;
 	for (int effectIndex = 0; effectIndex < m_effects.size(); effectIndex++)
@@ -298,6 +440,38 @@ void Player::ReceiveEffect(EffectDefinition const* definition, int stack)
 	if (newEffect)
 	{
 		m_effects.emplace_back(Effect(definition, stack, this, nullptr));
+		m_effectTriggers.OnEffectAdded(m_effects, static_cast<int>(m_effects.size()) - 1);
+	}
+}
+
+
+int Player::ModifyAmount(EffectTrigger trigger, int amount) const
+{
+	return m_effectTriggers.ApplyAmountModifiers(m_effects, trigger, amount);
+}
+
+
+void Player::ApplyTriggeredEffects(EffectTrigger trigger)
+{
+	int totalDamage = 0;
+	int totalBlock = 0;
+
+	std::vector<int> const& effectIndices = m_effectTriggers.GetEffectIndices(trigger);
+	for (int listIndex = 0; listIndex < effectIndices.size(); listIndex++)
+	{
+		Effect const& effect = m_effects[effectIndices[listIndex]];
+		totalDamage += effect.m_definition->m_triggerDamage * effect.m_stack;
+		totalBlock += effect.m_definition->m_triggerBlock * effect.m_stack;
+	}
+
+	//apply the totals once so a trigger shows up as a single combat number
+	if (totalBlock > 0)
+	{
+		GainBlock(totalBlock);
+	}
+	if (totalDamage > 0)
+	{
+		TakeDamage(totalDamage);
 	}
 }
 
@@ -387,7 +561,7 @@ void Player::ShuffleDrawPileFromDiscardPile()
 void Player::DrawCard()
 {
 	//if at max hand size, don't draw more cards
-	if (m_hand.size() == MAX_HAND_SIZE)
+	if (m_hand.size() >= MAX_HAND_SIZE)
 	{
 		return;
 	}
@@ -407,16 +581,8 @@ void Player::DrawCard()
 	//draw first card from draw pile
 	m_hand.emplace_back(m_drawPile[0]);
 	
-	//use erase-remove idiom to remove that card from the draw pile
-	m_drawPile.erase(std::remove_if(
-		m_drawPile.begin(),
-		m_drawPile.end(),
-		[=](auto const& element)
-		{
-			return element == m_drawPile[0];
-		}),
-		m_drawPile.end()
-	);
+	//the drawn card is always the first one, so there's no need to search the pile for it
+	m_drawPile.erase(m_drawPile.begin());
 }
 
 
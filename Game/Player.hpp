@@ -1,13 +1,17 @@
 #pragma once
 #include "Game/Card.hpp"
 #include "Game/Effect.hpp"
+#include "Game/CardLayout.hpp"
+#include "Game/HudLabel.hpp"
+#include "Game/SceneLayer.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
 
 //constants
 constexpr int PLAYER_MAX_HEALTH = 30;
 constexpr int PLAYER_START_ENERGY = 3;
-constexpr int MAX_HAND_SIZE = 5;
+constexpr int MAX_HAND_SIZE = 10;
+constexpr int CARDS_DRAWN_PER_TURN = 5;
 
 constexpr int REST_HEAL_AMOUNT = 10;
 
@@ -16,6 +20,7 @@ constexpr int REST_HEAL_AMOUNT = 10;
 class Enemy;
 class Encounter;
 class EffectDefinition;
+struct CombatEvent;
 
 
 class Player
@@ -26,9 +31,17 @@ public:
 	Player();
 
 	//game flow functions
-	void Update();
+	void Update(float deltaSeconds);
 	void Render() const;
 
+	//presentation functions
+	void PresentCombatEvent(CombatEvent const& event);
+	bool IsFlashing() const { return m_renderColor.r < 255 || m_renderColor.g < 255 || m_renderColor.b < 255; }
+
+	//click handlers
+	void OnHandCardClicked(int handIndex);
+	void OnPlayingFieldClicked(Enemy* enemyUnderCursor);
+
 	//player utilities
 	bool PlayCard(Card* cardToPlay, Enemy* enemyTarget);
 	void GainBlock(int blockAmount);
@@ -37,6 +50,8 @@ public:
 	void ReturnToStartEnergy();
 	void TakeDamage(int damageAmount);
 	void ReceiveEffect(EffectDefinition const* definition, int stack);
+	int ModifyAmount(EffectTrigger trigger, int amount) const;
+	void ApplyTriggeredEffects(EffectTrigger trigger);
 
 	//card management functions
 	void InitializeDeck();
@@ -65,9 +80,24 @@ public:
 	std::vector<Card*> m_tempAddedCards;
 
 	Card* m_selectedCard = nullptr;
+	CardLayout m_handLayout;
 
 	std::vector<Effect> m_effects;
+	EffectTriggerLists m_effectTriggers;	//indices into m_effects, bucketed by the triggers they respond to
 
 	AABB2 m_playerBounds = AABB2(200.0f, 350.0f, 550.0f, 600.0f);
 	Rgba8 m_renderColor = Rgba8();
+
+	//hud labels
+	HudLabel m_healthLabel = HudLabel("HP: %i/%i", Vec2(375.0f, 350.0f), 25.0f, Vec2(0.5f, 1.0f), Rgba8(255, 0, 0));
+	HudLabel m_blockLabel = HudLabel("Block: %i", Vec2(375.0f, 325.0f), 25.0f, Vec2(0.5f, 1.0f), Rgba8(0, 100, 255));
+	HudLabel m_energyLabel = HudLabel("Energy:\n%i/%i", Vec2(175.0f, 200.0f), 25.0f, Vec2(0.5f, 1.0f), Rgba8(255, 150, 0));
+	mutable HudLabel m_drawPileLabel = HudLabel("%i", Vec2(65.0f, 55.0f), 35.0f, Vec2(0.5f, 0.5f));
+	mutable HudLabel m_discardPileLabel = HudLabel("%i", Vec2(SCREEN_CAMERA_SIZE_X - 65.0f, 55.0f), 35.0f, Vec2(0.5f, 0.5f));
+	mutable std::vector<HudLabel> m_effectStackLabels;
+
+	//retained scene layers
+	mutable SceneLayer m_spriteLayer;
+	mutable Rgba8	   m_spriteLayerColor;	//hit flash color the sprite was built with
+	mutable SceneLayer m_pileLayer;			//draw and discard pile boxes, which never move
 };
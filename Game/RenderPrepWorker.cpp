@@ -0,0 +1,88 @@
+#include "Game/RenderPrepWorker.hpp"
+#include "Game/AllocationTracker.hpp"
+
+
+//
+//public game flow functions
+//
+void RenderPrepWorker::Startup()
+{
+	m_isQuitting = false;
+	m_thread = std::thread(&RenderPrepWorker::WorkerMain, this);
+}
+
+
+void RenderPrepWorker::Shutdown()
+{
+	if (!m_thread.joinable())
+	{
+		return;
+	}
+
+	//a job still in flight finishes first; its snapshot belongs to whoever kicked it, which is about to go away
+	WaitUntilIdle();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isQuitting = true;
+	}
+	m_condition.notify_all();
+
+	m_thread.join();
+}
+
+
+//
+//public job functions
+//
+void RenderPrepWorker::Kick(RenderPrepJob job, void* jobData)
+{
+	//without the thread nothing would ever finish the job, and the next wait would never return
+	GUARANTEE_OR_DIE(m_thread.joinable(), "RenderPrepWorker::Kick called before Startup!");
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this]() { return m_job == nullptr; });
+
+	m_job = job;
+	m_jobData = jobData;
+	lock.unlock();
+
+	m_condition.notify_all();
+}
+
+
+void RenderPrepWorker::WaitUntilIdle() const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this]() { return m_job == nullptr; });
+}
+
+
+//
+//private functions
+//
+void RenderPrepWorker::WorkerMain()
+{
+	ScopedAllocationTag allocationTag(AllocationTag::RENDER);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_condition.wait(lock, [this]() { return m_job != nullptr || m_isQuitting; });
+		if (m_isQuitting)
+		{
+			return;
+		}
+
+		RenderPrepJob job = m_job;
+		void* jobData = m_jobData;
+		lock.unlock();
+
+		job(jobData);
+
+		lock.lock();
+		m_job = nullptr;
+		m_jobData = nullptr;
+		m_condition.notify_all();
+	}
+}
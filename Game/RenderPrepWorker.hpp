@@ -0,0 +1,44 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+//typedefs
+typedef void (*RenderPrepJob)(void* jobData);
+
+
+//one thread that builds vertexes from a published snapshot while the main thread keeps going
+//jobs may only read their snapshot and write their own output; anything that talks to the renderer stays on the main thread
+//one job is in flight at a time: Kick waits out the previous job, and the main thread waits before touching what a job is building
+class RenderPrepWorker
+{
+//public member functions
+public:
+	RenderPrepWorker() = default;
+	RenderPrepWorker(RenderPrepWorker const& copyFrom) = delete;
+	RenderPrepWorker& operator=(RenderPrepWorker const& copyFrom) = delete;
+
+	//game flow functions
+	void Startup();
+	void Shutdown();
+
+	//job functions
+	void Kick(RenderPrepJob job, void* jobData);
+	void WaitUntilIdle() const;
+
+//private member functions
+private:
+	void WorkerMain();
+
+//private member variables
+private:
+	std::thread m_thread;
+
+	mutable std::mutex				m_mutex;
+	mutable std::condition_variable m_condition;
+	RenderPrepJob					m_job = nullptr;	//set while a job is waiting or running
+	void*							m_jobData = nullptr;
+	bool							m_isQuitting = false;
+};
@@ -0,0 +1,197 @@
+#include "Game/RunTelemetry.hpp"
+#include "Game/CardDefinition.hpp"
+#include "Game/Map.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+
+thread_local RunTelemetry g_runTelemetry;
+
+
+//constants
+static_assert(NUM_MAP_ENCOUNTERS <= TELEMETRY_MAX_ENCOUNTERS, "TELEMETRY_MAX_ENCOUNTERS must cover every encounter on the map");
+
+
+//
+//public run functions
+//
+void RunTelemetry::BeginRun(unsigned int seed)
+{
+	m_seed = seed;
+
+	//assign keeps the capacity, so after the first run this never allocates
+	m_cardDamage.assign(CardDefinition::s_cardDefs.size(), 0);
+	m_effectsApplied.assign(EffectDefinition::s_effectDefs.size(), 0);
+	m_playerBlockGained = 0;
+	m_enemyBlockGained = 0;
+	for (int encounterIndex = 0; encounterIndex < TELEMETRY_MAX_ENCOUNTERS; encounterIndex++)
+	{
+		m_encounterTurns[encounterIndex] = 0;
+		m_encounterHealthLost[encounterIndex] = 0;
+	}
+	m_numRewardsPicked = 0;
+	m_numRewardsSkipped = 0;
+}
+
+
+void RunTelemetry::EndRun(bool isVictory, int encountersCleared)
+{
+	if (!m_isCollecting)
+	{
+		return;
+	}
+
+	if (m_columnNames.empty())
+	{
+		BuildColumnNames();
+	}
+
+	//column order here has to match BuildColumnNames
+	int columnIndex = 0;
+	m_columns[columnIndex++].emplace_back(static_cast<int>(m_seed));
+	m_columns[columnIndex++].emplace_back(isVictory ? 1 : 0);
+	m_columns[columnIndex++].emplace_back(encountersCleared);
+	m_columns[columnIndex++].emplace_back(m_playerBlockGained);
+	m_columns[columnIndex++].emplace_back(m_enemyBlockGained);
+	m_columns[columnIndex++].emplace_back(m_numRewardsPicked);
+	m_columns[columnIndex++].emplace_back(m_numRewardsSkipped);
+	for (int encounterIndex = 0; encounterIndex < NUM_MAP_ENCOUNTERS; encounterIndex++)
+	{
+		m_columns[columnIndex++].emplace_back(m_encounterTurns[encounterIndex]);
+	}
+	for (int encounterIndex = 0; encounterIndex < NUM_MAP_ENCOUNTERS; encounterIndex++)
+	{
+		m_columns[columnIndex++].emplace_back(m_encounterHealthLost[encounterIndex]);
+	}
+	for (int cardDefIndex = 0; cardDefIndex < m_cardDamage.size() && columnIndex < m_columns.size(); cardDefIndex++)
+	{
+		m_columns[columnIndex++].emplace_back(m_cardDamage[cardDefIndex]);
+	}
+	for (int effectDefIndex = 0; effectDefIndex < m_effectsApplied.size() && columnIndex < m_columns.size(); effectDefIndex++)
+	{
+		m_columns[columnIndex++].emplace_back(m_effectsApplied[effectDefIndex]);
+	}
+}
+
+
+void RunTelemetry::SetCollecting(bool isCollecting)
+{
+	m_isCollecting = isCollecting;
+}
+
+
+//
+//public export functions
+//
+void RunTelemetry::AppendRunsFrom(RunTelemetry const& source)
+{
+	if (source.m_columnNames.empty())
+	{
+		return;
+	}
+
+	if (m_columnNames.empty())
+	{
+		m_columnNames = source.m_columnNames;
+		m_columns.resize(m_columnNames.size());
+	}
+
+	GUARANTEE_OR_DIE(m_columnNames == source.m_columnNames, "Can't merge telemetry recorded against different definitions!");
+
+	for (int columnIndex = 0; columnIndex < m_columns.size(); columnIndex++)
+	{
+		std::vector<int> const& sourceColumn = source.m_columns[columnIndex];
+		m_columns[columnIndex].insert(m_columns[columnIndex].end(), sourceColumn.begin(), sourceColumn.end());
+	}
+}
+
+
+void RunTelemetry::ClearRuns()
+{
+	for (int columnIndex = 0; columnIndex < m_columns.size(); columnIndex++)
+	{
+		m_columns[columnIndex].clear();
+	}
+}
+
+
+int RunTelemetry::GetNumRuns() const
+{
+	return m_columns.empty() ? 0 : static_cast<int>(m_columns[0].size());
+}
+
+
+bool RunTelemetry::WriteColumns(std::string const& filePath) const
+{
+	uint32_t numColumns = static_cast<uint32_t>(m_columns.size());
+	uint32_t numRows = static_cast<uint32_t>(GetNumRuns());
+
+	std::vector<uint8_t> buffer;
+	buffer.reserve(12 + numColumns * (32 + numRows * 4));
+
+	auto appendUint32 = [&buffer](uint32_t value)
+		{
+			buffer.emplace_back(static_cast<uint8_t>(value));
+			buffer.emplace_back(static_cast<uint8_t>(value >> 8));
+			buffer.emplace_back(static_cast<uint8_t>(value >> 16));
+			buffer.emplace_back(static_cast<uint8_t>(value >> 24));
+		};
+
+	buffer.emplace_back('T');
+	buffer.emplace_back('D');
+	buffer.emplace_back('T');
+	buffer.emplace_back('C');
+	appendUint32(numColumns);
+	appendUint32(numRows);
+
+	for (int columnIndex = 0; columnIndex < m_columns.size(); columnIndex++)
+	{
+		std::string const& columnName = m_columnNames[columnIndex];
+		size_t nameLength = columnName.size() < 255 ? columnName.size() : 255;
+		buffer.emplace_back(static_cast<uint8_t>(nameLength));
+		buffer.insert(buffer.end(), columnName.begin(), columnName.begin() + nameLength);
+
+		std::vector<int> const& column = m_columns[columnIndex];
+		for (int rowIndex = 0; rowIndex < column.size(); rowIndex++)
+		{
+			appendUint32(static_cast<uint32_t>(column[rowIndex]));
+		}
+	}
+
+	return FileWriteFromBuffer(buffer, filePath);
+}
+
+
+//
+//private functions
+//
+void RunTelemetry::BuildColumnNames()
+{
+	m_columnNames.clear();
+	m_columnNames.emplace_back("seed");
+	m_columnNames.emplace_back("victory");
+	m_columnNames.emplace_back("encountersCleared");
+	m_columnNames.emplace_back("playerBlockGained");
+	m_columnNames.emplace_back("enemyBlockGained");
+	m_columnNames.emplace_back("rewardsPicked");
+	m_columnNames.emplace_back("rewardsSkipped");
+	for (int encounterIndex = 0; encounterIndex < NUM_MAP_ENCOUNTERS; encounterIndex++)
+	{
+		m_columnNames.emplace_back(Stringf("turns.%i", encounterIndex));
+	}
+	for (int encounterIndex = 0; encounterIndex < NUM_MAP_ENCOUNTERS; encounterIndex++)
+	{
+		m_columnNames.emplace_back(Stringf("healthLost.%i", encounterIndex));
+	}
+	for (int cardDefIndex = 0; cardDefIndex < m_cardDamage.size(); cardDefIndex++)
+	{
+		m_columnNames.emplace_back("damage." + CardDefinition::s_cardDefs[cardDefIndex].m_name);
+	}
+	for (int effectDefIndex = 0; effectDefIndex < m_effectsApplied.size(); effectDefIndex++)
+	{
+		m_columnNames.emplace_back("applied." + EffectDefinition::s_effectDefs[effectDefIndex].m_name);
+	}
+
+	m_columns.clear();
+	m_columns.resize(m_columnNames.size());
+}
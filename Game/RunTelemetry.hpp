@@ -0,0 +1,94 @@
+#pragma once
+#include "Game/EffectDefinition.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//constants
+constexpr int TELEMETRY_MAX_ENCOUNTERS = 16;
+constexpr char const* TELEMETRY_FILE_PATH = "Telemetry.tdtc";	//runs played in the live game this session
+
+
+//gameplay counters for one run at a time, plus the finished runs as columns ready to export
+//every counter lives in storage sized once per run, so recording is an index and an add with no allocation or locking;
+//each thread has its own, so simulation workers never contend and the live game pays a few nanoseconds per event
+//
+//exported file ("TDTC"): 4cc, uint32 column count, uint32 row count, then per column a uint8 name length, the name,
+//and one little-endian int32 per run
+class RunTelemetry
+{
+//public member functions
+public:
+	//run functions
+	void BeginRun(unsigned int seed);
+	void EndRun(bool isVictory, int encountersCleared);
+	void SetCollecting(bool isCollecting);	//finished runs are only kept as columns while collecting
+
+	//recording functions
+	void RecordCardDamage(uint32_t cardDefIndex, int damageAmount)
+	{
+		if (cardDefIndex < m_cardDamage.size())
+		{
+			m_cardDamage[cardDefIndex] += damageAmount;
+		}
+	}
+	void RecordEffectApplied(EffectDefinition const* effectDef)
+	{
+		size_t effectDefIndex = static_cast<size_t>(effectDef - EffectDefinition::s_effectDefs.data());
+		if (effectDefIndex < m_effectsApplied.size())
+		{
+			m_effectsApplied[effectDefIndex]++;
+		}
+	}
+	void RecordPlayerBlock(int blockAmount) { m_playerBlockGained += blockAmount; }
+	void RecordEnemyBlock(int blockAmount)	{ m_enemyBlockGained += blockAmount; }
+	void RecordEncounterTurn(int encounterNumber, int turnNumber)
+	{
+		if (encounterNumber >= 0 && encounterNumber < TELEMETRY_MAX_ENCOUNTERS)
+		{
+			m_encounterTurns[encounterNumber] = turnNumber;
+		}
+	}
+	void RecordEncounterHealthLost(int encounterNumber, int healthAmount)
+	{
+		if (encounterNumber >= 0 && encounterNumber < TELEMETRY_MAX_ENCOUNTERS)
+		{
+			m_encounterHealthLost[encounterNumber] += healthAmount;
+		}
+	}
+	void RecordRewardPicked()  { m_numRewardsPicked++; }
+	void RecordRewardSkipped() { m_numRewardsSkipped++; }
+
+	//export functions
+	void AppendRunsFrom(RunTelemetry const& source);
+	void ClearRuns();
+	int GetNumRuns() const;
+	bool WriteColumns(std::string const& filePath) const;
+
+//private member functions
+private:
+	void BuildColumnNames();
+
+//private member variables
+private:
+	//current run
+	unsigned int	 m_seed = 0;
+	std::vector<int> m_cardDamage;		//indexed by card definition
+	std::vector<int> m_effectsApplied;	//indexed by effect definition
+	int				 m_playerBlockGained = 0;
+	int				 m_enemyBlockGained = 0;
+	int				 m_encounterTurns[TELEMETRY_MAX_ENCOUNTERS] = {};
+	int				 m_encounterHealthLost[TELEMETRY_MAX_ENCOUNTERS] = {};
+	int				 m_numRewardsPicked = 0;
+	int				 m_numRewardsSkipped = 0;
+
+	//finished runs
+	bool						  m_isCollecting = false;
+	std::vector<std::string>	  m_columnNames;
+	std::vector<std::vector<int>> m_columns;
+};
+
+
+extern thread_local RunTelemetry g_runTelemetry;
@@ -6,24 +6,71 @@
 #include "Game/App.hpp"
 #include "Game/CardDefinition.hpp"
 #include "Game/EncounterDefinition.hpp"
+#include "Game/AllocationTracker.hpp"
+#include "Game/RunTelemetry.hpp"
 #include "Engine/Core/FileUtils.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 
 
-SaveManager g_saveManager;
+thread_local SaveManager g_saveManager;
 
 
+//
+//varint helpers
+//
+//7 bits per byte, low bits first, high bit set on every byte but the last: ids and health under 128 take one byte
+static void AppendVarint(std::vector<uint8_t>& buffer, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		buffer.emplace_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	buffer.emplace_back(static_cast<uint8_t>(value));
+}
+
+
+static bool ReadVarint(std::vector<uint8_t> const& buffer, size_t& readPosition, uint32_t& out_value)
+{
+	out_value = 0;
+	for (int shift = 0; shift < 35; shift += 7)
+	{
+		if (readPosition >= buffer.size())
+		{
+			return false;
+		}
+
+		uint8_t byte = buffer[readPosition];
+		readPosition++;
+		out_value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+
+	//more than 5 bytes can't be a 32-bit value
+	return false;
+}
+
+
+//
+//public save functions
+//
 void SaveManager::RecordGameState()
 {
+	ScopedAllocationTag allocationTag(AllocationTag::SAVE);
+
 	//record rng variables
 	m_rngSeed = g_rng.m_seed;
 	m_rngPosition = g_rng.m_position;
 
 	//record encounter variables
 	Map* map = g_theGame->m_map;
-	m_encounterDefID = map->m_allEncounters[map->m_currentEncounterNumber]->m_definition->m_id;
-	m_encounterNumber = static_cast<uint8_t>(map->m_currentEncounterNumber);
+	m_encounterDef = map->m_allEncounters[map->m_currentEncounterNumber]->m_definition->m_handle;
+	m_encounterNumber = map->m_currentEncounterNumber;
 	if (map->m_isRestTime)
 	{
 		m_gameState = 2;
@@ -38,11 +85,11 @@ void SaveManager::RecordGameState()
 	}
 
 	//record player variables
-	m_playerCurrentHealth = static_cast<uint8_t>(g_theGame->m_player->m_currentHealth);
-	m_playerDeckCardDefIDs.clear();
+	m_playerCurrentHealth = g_theGame->m_player->m_currentHealth;
+	m_playerDeckCardDefs.clear();
 	for (int cardIndex = 0; cardIndex < g_theGame->m_player->m_deck.size(); cardIndex++)
 	{
-		m_playerDeckCardDefIDs.emplace_back((g_theGame->m_player->m_deck[cardIndex].m_definition->m_id));
+		m_playerDeckCardDefs.emplace_back((g_theGame->m_player->m_deck[cardIndex].m_definition->m_handle));
 	}
 
 	//std::string saveMessage = "Progress saved";
@@ -52,47 +99,33 @@ void SaveManager::RecordGameState()
 
 void SaveManager::SaveProgress()
 {
+	ScopedAllocationTag allocationTag(AllocationTag::SAVE);
+
 	DebuggerPrintf("Save\n");
 
 	std::vector<uint8_t> saveBuffer;
 
-	//write 4cc first ("TDTT")
+	//write 4cc first ("TDT2", "TDTT" was the old one byte per value format)
 	saveBuffer.emplace_back('T');
 	saveBuffer.emplace_back('D');
 	saveBuffer.emplace_back('T');
-	saveBuffer.emplace_back('T');
+	saveBuffer.emplace_back('2');
 
 	//then save rng variables
-	uint8_t rngSeedByte1 = static_cast<uint8_t>(m_rngSeed >> 24);
-	uint8_t rngSeedByte2 = static_cast<uint8_t>(m_rngSeed >> 16);
-	uint8_t rngSeedByte3 = static_cast<uint8_t>(m_rngSeed >> 8);
-	uint8_t rngSeedByte4 = static_cast<uint8_t>(m_rngSeed);
-
-	saveBuffer.emplace_back(rngSeedByte1);
-	saveBuffer.emplace_back(rngSeedByte2);
-	saveBuffer.emplace_back(rngSeedByte3);
-	saveBuffer.emplace_back(rngSeedByte4); 
-
-	uint8_t rngPositionByte1 = static_cast<uint8_t>(m_rngPosition >> 24);
-	uint8_t rngPositionByte2 = static_cast<uint8_t>(m_rngPosition >> 16);
-	uint8_t rngPositionByte3 = static_cast<uint8_t>(m_rngPosition >> 8);
-	uint8_t rngPositionByte4 = static_cast<uint8_t>(m_rngPosition);
-
-	saveBuffer.emplace_back(rngPositionByte1);
-	saveBuffer.emplace_back(rngPositionByte2);
-	saveBuffer.emplace_back(rngPositionByte3);
-	saveBuffer.emplace_back(rngPositionByte4);
+	AppendVarint(saveBuffer, m_rngSeed);
+	AppendVarint(saveBuffer, static_cast<uint32_t>(m_rngPosition));
 
 	//then save encounter variables
-	saveBuffer.emplace_back(m_encounterDefID);
-	saveBuffer.emplace_back(m_encounterNumber);
-	saveBuffer.emplace_back(m_gameState);
-
-	//then save player variables
-	saveBuffer.emplace_back(m_playerCurrentHealth);
-	for (int cardIndex = 0; cardIndex < m_playerDeckCardDefIDs.size(); cardIndex++)
+	AppendVarint(saveBuffer, m_encounterDef.GetIndex());
+	AppendVarint(saveBuffer, static_cast<uint32_t>(m_encounterNumber));
+	AppendVarint(saveBuffer, static_cast<uint32_t>(m_gameState));
+
+	//then save player variables, the deck is length-prefixed
+	AppendVarint(saveBuffer, static_cast<uint32_t>(m_playerCurrentHealth));
+	AppendVarint(saveBuffer, static_cast<uint32_t>(m_playerDeckCardDefs.size()));
+	for (int cardIndex = 0; cardIndex < m_playerDeckCardDefs.size(); cardIndex++)
 	{
-		saveBuffer.emplace_back(m_playerDeckCardDefIDs[cardIndex]);
+		AppendVarint(saveBuffer, m_playerDeckCardDefs[cardIndex].GetIndex());
 	}
 	
 	std::string saveFilePath = "Save.bin";
@@ -103,6 +136,8 @@ void SaveManager::SaveProgress()
 
 bool SaveManager::LoadProgress()
 {
+	ScopedAllocationTag allocationTag(AllocationTag::LOAD);
+
 	std::string saveFilePath = "Save.bin";
 	if (!CheckForFile(saveFilePath))
 	{
@@ -113,42 +148,42 @@ bool SaveManager::LoadProgress()
 
 	FileReadToBuffer(saveBuffer, saveFilePath);
 
-	//check 4cc ("TDTT")
-	if (saveBuffer.size() < 15)
+	//check 4cc ("TDT2", or "TDTT" for saves from before varints)
+	if (saveBuffer.size() < 4)
 	{
 		ERROR_RECOVERABLE("Save file too small!");
 		return false;
 	}
-	if (saveBuffer[0] != 'T' || saveBuffer[1] != 'D' || saveBuffer[2] != 'T' || saveBuffer[3] != 'T')
+	if (saveBuffer[0] != 'T' || saveBuffer[1] != 'D' || saveBuffer[2] != 'T' || (saveBuffer[3] != '2' && saveBuffer[3] != 'T'))
 	{
 		ERROR_RECOVERABLE("4cc was incorrect!");
 		return false;
 	}
 
-	//load rng state
-	unsigned int rngSeedByte1 = static_cast<unsigned int>(saveBuffer[4]) << 24;
-	unsigned int rngSeedByte2 = static_cast<unsigned int>(saveBuffer[5]) << 16;
-	unsigned int rngSeedByte3 = static_cast<unsigned int>(saveBuffer[6]) << 8;
-	unsigned int rngSeedByte4 = static_cast<unsigned int>(saveBuffer[7]);
-	m_rngSeed = rngSeedByte4 | rngSeedByte3 | rngSeedByte2 | rngSeedByte1;
-
-	unsigned int rngPositionByte1 = static_cast<unsigned int>(saveBuffer[8]) << 24;
-	unsigned int rngPositionByte2 = static_cast<unsigned int>(saveBuffer[9]) << 16;
-	unsigned int rngPositionByte3 = static_cast<unsigned int>(saveBuffer[10]) << 8;
-	unsigned int rngPositionByte4 = static_cast<unsigned int>(saveBuffer[11]);
-	m_rngPosition = rngPositionByte4 | rngPositionByte3 | rngPositionByte2 | rngPositionByte1;
-
-	//load encounter and map state
-	m_encounterDefID = saveBuffer[12];
-	m_encounterNumber = saveBuffer[13];
-	m_gameState = saveBuffer[14];
+	bool isRead = (saveBuffer[3] == '2') ? ReadSaveBuffer(saveBuffer) : ReadLegacySaveBuffer(saveBuffer);
+	if (!isRead)
+	{
+		return false;
+	}
 
-	//load player state
-	m_playerCurrentHealth = saveBuffer[15];
-	m_playerDeckCardDefIDs.clear();
-	for (int bufferIndex = 16; bufferIndex < saveBuffer.size(); bufferIndex++)
+	//every saved id has to name a definition that's actually loaded, and the encounter number a slot on the map
+	if (m_encounterNumber < 0 || m_encounterNumber >= NUM_MAP_ENCOUNTERS)
 	{
-		m_playerDeckCardDefIDs.emplace_back(saveBuffer[bufferIndex]);
+		ERROR_RECOVERABLE("Save file refers to an encounter past the end of the map!");
+		return false;
+	}
+	if (EncounterDefinition::GetEncounterDefinition(m_encounterDef) == nullptr)
+	{
+		ERROR_RECOVERABLE("Save file refers to an encounter that doesn't exist!");
+		return false;
+	}
+	for (int cardIndex = 0; cardIndex < m_playerDeckCardDefs.size(); cardIndex++)
+	{
+		if (CardDefinition::GetCardDefinition(m_playerDeckCardDefs[cardIndex]) == nullptr)
+		{
+			ERROR_RECOVERABLE("Save file refers to a card that doesn't exist!");
+			return false;
+		}
 	}
 
 	//create player and map
@@ -156,13 +191,17 @@ bool SaveManager::LoadProgress()
 	Player* player = g_theGame->m_player;
 	player->m_currentHealth = m_playerCurrentHealth;
 	player->m_deck.clear();
-	for (int cardIndex = 0; cardIndex < m_playerDeckCardDefIDs.size(); cardIndex++)
+	for (int cardIndex = 0; cardIndex < m_playerDeckCardDefs.size(); cardIndex++)
 	{
-		player->m_deck.emplace_back(Card(&CardDefinition::s_cardDefs[m_playerDeckCardDefIDs[cardIndex]], player));
+		player->m_deck.emplace_back(Card(CardDefinition::GetCardDefinition(m_playerDeckCardDefs[cardIndex]), player));
 	}
 
 	g_rng.SeedRNG(m_rngSeed);
 	g_rng.m_position = 0;
+
+	//a continued save starts a fresh telemetry run; counters from before the save aren't kept
+	g_runTelemetry.BeginRun(m_rngSeed);
+
 	g_theGame->m_map = new Map(g_theGame->m_player);
 	Map* map = g_theGame->m_map;
 	//actually use loaded encounter and map state variables
@@ -186,6 +225,7 @@ bool SaveManager::LoadProgress()
 
 	g_theGame->m_map->m_allEncounters[m_encounterNumber]->BeginEncounter();
 
+#if !defined(GAME_HEADLESS)
 	//set appropriate music
 	if (map->m_isRestTime)
 	{
@@ -222,6 +262,102 @@ bool SaveManager::LoadProgress()
 			g_battleMusicPlayback = g_theAudio->StartSound(g_battleMusic, true);
 		}
 	}
+#endif
+
+	return true;
+}
+
+
+//
+//private save file parsing functions
+//
+bool SaveManager::ReadSaveBuffer(std::vector<uint8_t> const& saveBuffer)
+{
+	size_t readPosition = 4;
+	uint32_t rngPosition = 0;
+	uint32_t encounterDefIndex = 0;
+	uint32_t encounterNumber = 0;
+	uint32_t gameState = 0;
+	uint32_t playerCurrentHealth = 0;
+	uint32_t deckSize = 0;
+
+	bool isRead = ReadVarint(saveBuffer, readPosition, m_rngSeed)
+		&& ReadVarint(saveBuffer, readPosition, rngPosition)
+		&& ReadVarint(saveBuffer, readPosition, encounterDefIndex)
+		&& ReadVarint(saveBuffer, readPosition, encounterNumber)
+		&& ReadVarint(saveBuffer, readPosition, gameState)
+		&& ReadVarint(saveBuffer, readPosition, playerCurrentHealth)
+		&& ReadVarint(saveBuffer, readPosition, deckSize);
+	if (!isRead)
+	{
+		ERROR_RECOVERABLE("Save file is truncated!");
+		return false;
+	}
+
+	m_rngPosition = static_cast<int>(rngPosition);
+	m_encounterDef = EncounterDefinition::GetEncounterDefHandle(encounterDefIndex);
+	m_encounterNumber = static_cast<int>(encounterNumber);
+	m_gameState = static_cast<int>(gameState);
+	m_playerCurrentHealth = static_cast<int>(playerCurrentHealth);
+
+	//every card takes at least a byte, so a bogus deck size can't make this reserve more than the file could hold
+	if (deckSize > saveBuffer.size() - readPosition)
+	{
+		ERROR_RECOVERABLE("Save file is truncated!");
+		return false;
+	}
+
+	m_playerDeckCardDefs.clear();
+	m_playerDeckCardDefs.reserve(deckSize);
+	for (uint32_t cardIndex = 0; cardIndex < deckSize; cardIndex++)
+	{
+		uint32_t cardDefIndex = 0;
+		if (!ReadVarint(saveBuffer, readPosition, cardDefIndex))
+		{
+			ERROR_RECOVERABLE("Save file is truncated!");
+			return false;
+		}
+		m_playerDeckCardDefs.emplace_back(CardDefinition::GetCardDefHandle(cardDefIndex));
+	}
+
+	return true;
+}
+
+
+bool SaveManager::ReadLegacySaveBuffer(std::vector<uint8_t> const& saveBuffer)
+{
+	//"TDTT": big-endian seed and position, then one byte each for encounter id, encounter number, game state, health and every card
+	if (saveBuffer.size() < 16)
+	{
+		ERROR_RECOVERABLE("Save file too small!");
+		return false;
+	}
+
+	//load rng state
+	unsigned int rngSeedByte1 = static_cast<unsigned int>(saveBuffer[4]) << 24;
+	unsigned int rngSeedByte2 = static_cast<unsigned int>(saveBuffer[5]) << 16;
+	unsigned int rngSeedByte3 = static_cast<unsigned int>(saveBuffer[6]) << 8;
+	unsigned int rngSeedByte4 = static_cast<unsigned int>(saveBuffer[7]);
+	m_rngSeed = rngSeedByte4 | rngSeedByte3 | rngSeedByte2 | rngSeedByte1;
+
+	unsigned int rngPositionByte1 = static_cast<unsigned int>(saveBuffer[8]) << 24;
+	unsigned int rngPositionByte2 = static_cast<unsigned int>(saveBuffer[9]) << 16;
+	unsigned int rngPositionByte3 = static_cast<unsigned int>(saveBuffer[10]) << 8;
+	unsigned int rngPositionByte4 = static_cast<unsigned int>(saveBuffer[11]);
+	m_rngPosition = rngPositionByte4 | rngPositionByte3 | rngPositionByte2 | rngPositionByte1;
+
+	//load encounter and map state
+	m_encounterDef = EncounterDefinition::GetEncounterDefHandle(saveBuffer[12]);
+	m_encounterNumber = saveBuffer[13];
+	m_gameState = saveBuffer[14];
+
+	//load player state
+	m_playerCurrentHealth = saveBuffer[15];
+	m_playerDeckCardDefs.clear();
+	for (int bufferIndex = 16; bufferIndex < saveBuffer.size(); bufferIndex++)
+	{
+		m_playerDeckCardDefs.emplace_back(CardDefinition::GetCardDefHandle(saveBuffer[bufferIndex]));
+	}
 
 	return true;
 }
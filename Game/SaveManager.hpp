@@ -1,4 +1,6 @@
 #pragma once
+#include "Game/CardDefinition.hpp"
+#include "Game/EncounterDefinition.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
 
@@ -10,6 +12,12 @@ public:
 	void SaveProgress();
 	bool LoadProgress();
 
+//private member functions
+private:
+	//save file parsing functions
+	bool ReadSaveBuffer(std::vector<uint8_t> const& saveBuffer);
+	bool ReadLegacySaveBuffer(std::vector<uint8_t> const& saveBuffer);
+
 //public member variables
 public:
 	//rng variables
@@ -17,13 +25,13 @@ public:
 	int m_rngPosition = 0;
 
 	//encounter variables
-	uint8_t m_encounterDefID = 0;
-	uint8_t m_encounterNumber = 0;
-	uint8_t m_gameState = 0;	   //0 = normal, 1 = in card reward screen, 2 = in rest stop
+	EncounterDefHandle m_encounterDef;
+	int m_encounterNumber = 0;
+	int m_gameState = 0;	   //0 = normal, 1 = in card reward screen, 2 = in rest stop
 
 	//player variables
-	uint8_t m_playerCurrentHealth = 0;
-	std::vector<uint8_t> m_playerDeckCardDefIDs;
+	int m_playerCurrentHealth = 0;
+	std::vector<CardDefHandle> m_playerDeckCardDefs;
 };
 
-extern SaveManager g_saveManager;
+extern thread_local SaveManager g_saveManager;
@@ -0,0 +1,32 @@
+#include "Game/SceneLayer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+
+#if !defined(GAME_HEADLESS)
+//
+//public building functions
+//
+std::vector<Vertex_PCU>& SceneLayer::BeginRebuild(Texture const* texture)
+{
+	m_isDirty = false;
+	m_texture = texture;
+	m_verts.clear();
+
+	return m_verts;
+}
+
+
+//
+//public game flow functions
+//
+void SceneLayer::Render() const
+{
+	if (m_verts.empty())
+	{
+		return;
+	}
+
+	g_theRenderer->BindTexture(m_texture);
+	g_theRenderer->DrawVertexArray(m_verts);
+}
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include <vector>
+
+
+//a retained piece of the combat scene: vertexes built once, then redrawn as they are every frame until what they show changes
+//like HudLabel, it's compare-on-render: the owner keeps copies of what the layer was built from (bounds, colour, definition
+//revision) and rebuilds when they differ, so a frame where nothing changed only re-submits cached vertexes and builds nothing
+class SceneLayer
+{
+//public member functions
+public:
+	//dirty tracking
+	bool IsDirty() const { return m_isDirty; }	//only until the first rebuild; after that the owner's comparisons decide
+
+	//building functions
+	std::vector<Vertex_PCU>& BeginRebuild(Texture const* texture);	//empties the layer for refilling and marks it clean
+
+	//game flow functions
+	void Render() const;
+
+//private member variables
+private:
+	std::vector<Vertex_PCU> m_verts;	//cleared rather than freed on rebuild, so rebuilding the same shapes doesn't allocate
+	Texture const*			m_texture = nullptr;
+	bool					m_isDirty = true;
+};
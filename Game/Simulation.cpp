@@ -0,0 +1,441 @@
+#include "Game/Simulation.hpp"
+#include "Game/App.hpp"
+#include "Game/Game.hpp"
+#include "Game/Map.hpp"
+#include "Game/Player.hpp"
+#include "Game/Enemy.hpp"
+#include "Game/Encounter.hpp"
+#include "Game/CardDefinition.hpp"
+#include "Game/EffectDefinition.hpp"
+#include "Game/EnemyDefinition.hpp"
+#include "Game/EncounterDefinition.hpp"
+#include "Game/GameStateHasher.hpp"
+#include "Game/CombatState.hpp"
+#include "Game/RunTelemetry.hpp"
+#include "Game/GameCommon.hpp"
+
+
+//
+//constructor and destructor
+//
+Simulation::Simulation(unsigned int seed)
+	: m_seed(seed)
+{
+	//autoplayer decisions use their own rng so they never shift the game's rng stream
+	m_decisionRNG.SeedRNG(seed);
+	m_decisionRNG.m_position = 0;
+
+	m_result.m_seed = seed;
+}
+
+
+Simulation::~Simulation()
+{
+	if (m_game != nullptr)
+	{
+		if (m_game->m_map != nullptr)
+		{
+			delete m_game->m_map;
+		}
+
+		if (m_game->m_player != nullptr)
+		{
+			m_game->m_player->ResetCards();	//frees cards enemies added mid-encounter
+			delete m_game->m_player;
+		}
+
+		delete m_game;
+	}
+
+	if (g_theGame == m_game)
+	{
+		g_theGame = nullptr;
+	}
+}
+
+
+//
+//public simulation flow functions
+//
+SimulationResult Simulation::Run()
+{
+	//each worker thread has its own game and rng, so runs never see each other's state
+	m_game = new Game();
+	g_theGame = m_game;
+
+	g_rng.SeedRNG(m_seed);
+	g_rng.m_position = 0;
+	g_runTelemetry.BeginRun(m_seed);
+
+	m_game->m_isAttractMode = false;
+	m_game->m_player = new Player();
+	m_game->m_map = new Map(m_game->m_player);
+	m_game->m_map->EnterFirstEncounter();
+
+	Player* player = m_game->m_player;
+	Map* map = m_game->m_map;
+
+	ConsumeCombatEvents();
+	RecordStateHash();
+
+	while (!m_game->m_isVictory && player->m_currentHealth > 0)
+	{
+		ConsumeCombatEvents();
+
+		if (map->m_isRestTime)
+		{
+			//always rest; mirrors Game::Event_PlayerRest
+			player->RestoreHealth(REST_HEAL_AMOUNT);
+			map->EnterNextEncounter();
+			ConsumeCombatEvents();
+			RecordStateHash();
+			continue;
+		}
+
+		Encounter* encounter = map->m_allEncounters[map->m_currentEncounterNumber];
+
+		if (encounter->AreAllEnemiesDead())
+		{
+			ResolveEncounterVictory(encounter);
+			continue;
+		}
+
+		if (encounter->m_turnNumber > SIMULATION_MAX_TURNS_PER_ENCOUNTER)
+		{
+			m_result.m_isStalemate = true;
+			break;
+		}
+
+		if (m_roundTrips != nullptr)
+		{
+			CheckCombatStateRoundTrip(encounter);
+		}
+
+		PlayPlayerTurn(encounter);
+
+		if (encounter->AreAllEnemiesDead())
+		{
+			continue;
+		}
+
+		encounter->ResolveEnemyTurn();
+		ConsumeCombatEvents();
+		RecordStateHash();
+	}
+
+	ConsumeCombatEvents();
+
+	m_result.m_isVictory = m_game->m_isVictory;
+	m_result.m_finalHealth = player->m_currentHealth;
+	m_result.m_finalDeckSize = static_cast<int>(player->m_deck.size());
+
+	g_runTelemetry.EndRun(m_result.m_isVictory, m_result.m_encountersCleared);
+
+	return m_result;
+}
+
+
+//
+//public harness functions
+//
+void Simulation::SetDecisionScript(std::vector<int> const* decisionScript)
+{
+	m_decisionScript = (decisionScript != nullptr && !decisionScript->empty()) ? decisionScript : nullptr;
+	m_decisionScriptPosition = 0;
+}
+
+
+void Simulation::SetStateHashOutput(std::vector<uint64_t>* out_stateHashes)
+{
+	m_stateHashes = out_stateHashes;
+}
+
+
+void Simulation::SetRoundTripOutput(RoundTripResult* out_roundTrips)
+{
+	m_roundTrips = out_roundTrips;
+}
+
+
+//
+//static functions
+//
+void Simulation::InitializeDefinitions()
+{
+	//mirrors Game::InitializeDefinitions, which the headless build doesn't compile; must run once before any worker starts
+	if (EffectDefinition::s_effectDefs.size() == 0)
+	{
+		EffectDefinition::InitializeEffectDefs();
+	}
+	if (CardDefinition::s_cardDefs.size() == 0)
+	{
+		CardDefinition::InitializeCardDefs();
+	}
+	if (EnemyDefinition::s_enemyDefs.size() == 0)
+	{
+		EnemyDefinition::InitializeEnemyDefs();
+	}
+	if (EncounterDefinition::s_encounterDefs.size() == 0)
+	{
+		EncounterDefinition::InitializeEncounterDefs();
+	}
+}
+
+
+//
+//private turn functions
+//
+void Simulation::PlayPlayerTurn(Encounter* encounter)
+{
+	m_result.m_totalTurns++;
+
+	for (int playNum = 0; playNum < SIMULATION_MAX_PLAYS_PER_TURN; playNum++)
+	{
+		Card* cardToPlay = ChooseCardToPlay();
+		if (cardToPlay == nullptr)
+		{
+			return;
+		}
+
+		Enemy* enemyTarget = nullptr;
+		if (cardToPlay->m_definition->m_targetMode == TargetMode::ONE)
+		{
+			enemyTarget = ChooseEnemyTarget(encounter);
+		}
+
+		if (!m_game->m_player->PlayCard(cardToPlay, enemyTarget))
+		{
+			return;
+		}
+
+		m_result.m_cardsPlayed++;
+		ConsumeCombatEvents();
+		RecordStateHash();
+
+		if (encounter->AreAllEnemiesDead())
+		{
+			return;
+		}
+	}
+}
+
+
+void Simulation::ResolveEncounterVictory(Encounter* encounter)
+{
+	m_result.m_encountersCleared++;
+
+	//mirrors the victory handling in Game::Update
+	if (encounter->m_encounterNumber == m_game->m_map->m_allEncounters.size() - 1)
+	{
+		m_game->m_isVictory = true;
+		RecordStateHash();
+		return;
+	}
+
+	encounter->OpenCardRewardScreen();
+
+	//accepting a reward enters the next encounter, which deletes this one
+	int rewardIndex = (m_decisionScript != nullptr) ? ChooseScriptedOption(NUM_CARD_REWARDS) : m_decisionRNG.RollRandomIntLessThan(NUM_CARD_REWARDS);
+	encounter->AcceptCardReward(rewardIndex);
+
+	ConsumeCombatEvents();
+	RecordStateHash();
+}
+
+
+//
+//private combat event functions
+//
+void Simulation::ConsumeCombatEvents()
+{
+	//there's nothing to present, so events are only tallied; draining after every action keeps the queue from filling up
+	CombatEvent event;
+	while (m_game->m_combatEvents.Pop(event))
+	{
+		if (event.m_type != CombatEventType::HIT)
+		{
+			continue;
+		}
+
+		if (event.m_enemy != nullptr)
+		{
+			m_result.m_damageDealt += event.m_amount;
+		}
+		else
+		{
+			m_result.m_damageTaken += event.m_amount;
+		}
+	}
+}
+
+
+//
+//private harness functions
+//
+void Simulation::RecordStateHash()
+{
+	if (m_stateHashes != nullptr)
+	{
+		m_stateHashes->emplace_back(GameStateHasher::HashGame(*m_game));
+	}
+}
+
+
+//plays the coming player turn and enemy turn on the live game, then restores the state captured before them
+//the real turn that follows makes the same decisions and rolls, so a correct restore leaves the run's hashes untouched
+void Simulation::CheckCombatStateRoundTrip(Encounter* encounter)
+{
+	Player* player = m_game->m_player;
+
+	CombatState capturedState;
+	if (!capturedState.Capture(*player, *encounter))
+	{
+		return;
+	}
+	uint64_t capturedHash = GameStateHasher::HashGame(*m_game);
+
+	//everything the fork touches outside the game state is put back by hand
+	SimulationResult capturedResult = m_result;
+	RandomNumberGenerator capturedDecisionRNG = m_decisionRNG;
+	int capturedDecisionScriptPosition = m_decisionScriptPosition;
+	std::vector<uint64_t>* stateHashes = m_stateHashes;
+	m_stateHashes = nullptr;
+
+	std::vector<Card*> capturedHand = player->m_hand;
+	int numCapturedAddedCards = static_cast<int>(player->m_tempAddedCards.size());
+	int numCapturedLivingEnemies = 0;
+	for (int enemyIndex = 0; enemyIndex < encounter->m_currentEnemies.size(); enemyIndex++)
+	{
+		Enemy const* enemy = encounter->m_currentEnemies[enemyIndex];
+		if (enemy != nullptr && enemy->m_currentHealth > 0)
+		{
+			numCapturedLivingEnemies++;
+		}
+	}
+
+	//the fork
+	PlayPlayerTurn(encounter);
+	if (!encounter->AreAllEnemiesDead())
+	{
+		encounter->ResolveEnemyTurn();
+	}
+	ConsumeCombatEvents();
+
+	int numLivingEnemies = 0;
+	for (int enemyIndex = 0; enemyIndex < encounter->m_currentEnemies.size(); enemyIndex++)
+	{
+		Enemy const* enemy = encounter->m_currentEnemies[enemyIndex];
+		if (enemy != nullptr && enemy->m_currentHealth > 0)
+		{
+			numLivingEnemies++;
+		}
+	}
+
+	m_roundTrips->m_numForks++;
+	if (static_cast<int>(player->m_tempAddedCards.size()) > numCapturedAddedCards)
+	{
+		m_roundTrips->m_numForksAddingCards++;
+	}
+	if (numLivingEnemies < numCapturedLivingEnemies)
+	{
+		m_roundTrips->m_numForksKillingEnemies++;
+	}
+	if (player->m_hand != capturedHand)
+	{
+		m_roundTrips->m_numForksChangingHand++;
+	}
+
+	capturedState.Restore(*player, *encounter);
+	if (GameStateHasher::HashGame(*m_game) != capturedHash)
+	{
+		m_roundTrips->m_numMismatches++;
+	}
+
+	m_result = capturedResult;
+	m_decisionRNG = capturedDecisionRNG;
+	m_decisionScriptPosition = capturedDecisionScriptPosition;
+	m_stateHashes = stateHashes;
+}
+
+
+//
+//private autoplayer decisions
+//
+Card* Simulation::ChooseCardToPlay()
+{
+	Player* player = m_game->m_player;
+
+	std::vector<Card*> playableCards;
+	for (int handIndex = 0; handIndex < player->m_hand.size(); handIndex++)
+	{
+		Card* card = player->m_hand[handIndex];
+		if (card->m_definition->m_isPlayable && card->m_definition->m_cost <= player->m_currentEnergy)
+		{
+			if (m_decisionScript == nullptr)
+			{
+				return card;
+			}
+			playableCards.emplace_back(card);
+		}
+	}
+
+	if (playableCards.empty())
+	{
+		return nullptr;
+	}
+
+	return playableCards[ChooseScriptedOption(static_cast<int>(playableCards.size()))];
+}
+
+
+Enemy* Simulation::ChooseEnemyTarget(Encounter* encounter)
+{
+	if (m_decisionScript != nullptr)
+	{
+		std::vector<Enemy*> livingEnemies;
+		for (int enemyIndex = 0; enemyIndex < encounter->m_currentEnemies.size(); enemyIndex++)
+		{
+			Enemy* enemy = encounter->m_currentEnemies[enemyIndex];
+			if (enemy != nullptr && enemy->m_currentHealth > 0)
+			{
+				livingEnemies.emplace_back(enemy);
+			}
+		}
+
+		if (livingEnemies.empty())
+		{
+			return nullptr;
+		}
+
+		return livingEnemies[ChooseScriptedOption(static_cast<int>(livingEnemies.size()))];
+	}
+
+	//focus the living enemy with the least health
+	Enemy* bestTarget = nullptr;
+	for (int enemyIndex = 0; enemyIndex < encounter->m_currentEnemies.size(); enemyIndex++)
+	{
+		Enemy* enemy = encounter->m_currentEnemies[enemyIndex];
+		if (enemy == nullptr || enemy->m_currentHealth == 0)
+		{
+			continue;
+		}
+
+		if (bestTarget == nullptr || enemy->m_currentHealth < bestTarget->m_currentHealth)
+		{
+			bestTarget = enemy;
+		}
+	}
+
+	return bestTarget;
+}
+
+
+int Simulation::ChooseScriptedOption(int numOptions)
+{
+	//the script wraps around, and each entry picks among whatever options exist at that point
+	int decision = (*m_decisionScript)[m_decisionScriptPosition % m_decisionScript->size()];
+	m_decisionScriptPosition++;
+
+	int option = decision % numOptions;
+	return (option < 0) ? option + numOptions : option;
+}
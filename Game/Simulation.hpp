@@ -0,0 +1,99 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include <cstdint>
+#include <vector>
+
+
+//forward declarations
+class Game;
+class Card;
+class Enemy;
+class Encounter;
+
+
+//constants
+constexpr int SIMULATION_MAX_TURNS_PER_ENCOUNTER = 200;
+constexpr int SIMULATION_MAX_PLAYS_PER_TURN = 64;
+
+
+//results of one full simulated run
+struct SimulationResult
+{
+	unsigned int m_seed = 0;
+	bool		 m_isVictory = false;
+	bool		 m_isStalemate = false;
+	int			 m_encountersCleared = 0;
+	int			 m_finalHealth = 0;
+	int			 m_totalTurns = 0;
+	int			 m_cardsPlayed = 0;
+	int			 m_finalDeckSize = 0;
+	int			 m_damageDealt = 0;
+	int			 m_damageTaken = 0;
+};
+
+
+//what the combat state round trip check saw over one run; a fork plays a whole turn, so the counts show what the restores covered
+struct RoundTripResult
+{
+	int m_numForks = 0;
+	int m_numMismatches = 0;			//forks whose restore didn't bring back the hash the game had when it was captured
+	int m_numForksAddingCards = 0;
+	int m_numForksKillingEnemies = 0;
+	int m_numForksChangingHand = 0;
+};
+
+
+//runs a whole game with the real Map, Encounter, Player and Enemy rules, with no window, renderer, input or audio
+//decisions are made by a simple greedy autoplayer, or read from a decision script, so results are fully determined by the seed
+//(and the script); the determinism harness also has it hash the whole game state after every action, and can have it fork
+//every player turn through a CombatState to check that restoring one brings back exactly the captured game
+class Simulation
+{
+//public member functions
+public:
+	//constructor and destructor
+	explicit Simulation(unsigned int seed);
+	~Simulation();
+
+	//simulation flow functions
+	SimulationResult Run();
+
+	//harness functions, all must be called before Run
+	void SetDecisionScript(std::vector<int> const* decisionScript);	//decisions cycle through the script instead of the autoplayer
+	void SetStateHashOutput(std::vector<uint64_t>* out_stateHashes);	//one hash per action, starting with the initial state
+	void SetRoundTripOutput(RoundTripResult* out_roundTrips);			//forks are invisible to the hashes and results, not to telemetry
+
+	//static functions
+	static void InitializeDefinitions();
+
+//private member functions
+private:
+	//turn functions
+	void PlayPlayerTurn(Encounter* encounter);
+	void ResolveEncounterVictory(Encounter* encounter);
+
+	//combat event functions
+	void ConsumeCombatEvents();
+
+	//harness functions
+	void RecordStateHash();
+	void CheckCombatStateRoundTrip(Encounter* encounter);
+
+	//autoplayer decisions
+	Card* ChooseCardToPlay();
+	Enemy* ChooseEnemyTarget(Encounter* encounter);
+	int ChooseScriptedOption(int numOptions);
+
+//private member variables
+private:
+	unsigned int m_seed = 0;
+	Game* m_game = nullptr;
+	RandomNumberGenerator m_decisionRNG;
+	SimulationResult m_result;
+
+	std::vector<int> const* m_decisionScript = nullptr;
+	int m_decisionScriptPosition = 0;
+	std::vector<uint64_t>* m_stateHashes = nullptr;
+	RoundTripResult* m_roundTrips = nullptr;
+};
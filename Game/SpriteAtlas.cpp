@@ -0,0 +1,115 @@
+#include "Game/SpriteAtlas.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+SpriteAtlas g_spriteAtlas;
+
+
+//
+//public game flow functions
+//
+void SpriteAtlas::Startup()
+{
+	m_pages.clear();
+	m_sprites.clear();
+
+	//no atlas just means every sprite loads on its own
+	if (!CheckForFile(SPRITE_ATLAS_FILE_PATH))
+	{
+		return;
+	}
+
+	XmlDocument atlasXml;
+	XmlError result = atlasXml.LoadFile(SPRITE_ATLAS_FILE_PATH);
+	if (result != tinyxml2::XML_SUCCESS || atlasXml.RootElement() == nullptr)
+	{
+		ERROR_RECOVERABLE("Failed to read the sprite atlas, loading sprites individually");
+		return;
+	}
+
+	XmlElement const* element = atlasXml.RootElement()->FirstChildElement();
+	while (element != nullptr)
+	{
+		std::string elementName = element->Name();
+		if (elementName == "Page")
+		{
+			std::string pageFilePath = ParseXmlAttribute(*element, "texture", "invalid file path");
+			m_pages.emplace_back(g_theRenderer->CreateOrGetTextureFromFile(pageFilePath.c_str()));
+		}
+		else if (elementName == "Sprite")
+		{
+			std::string sourceFilePath = ParseXmlAttribute(*element, "source", "");
+			int pageIndex = ParseXmlAttribute(*element, "page", -1);
+			if (pageIndex >= 0 && pageIndex < m_pages.size())
+			{
+				AtlasSprite sprite;
+				sprite.m_texture = m_pages[pageIndex];
+				sprite.m_uvs = ParseXmlAttribute(*element, "uvs", sprite.m_uvs);
+				m_sprites[sourceFilePath] = sprite;
+			}
+			else
+			{
+				ERROR_RECOVERABLE(Stringf("Sprite atlas entry for %s names a page that doesn't exist", sourceFilePath.c_str()));
+			}
+		}
+
+		element = element->NextSiblingElement();
+	}
+}
+
+
+//
+//public accessors
+//
+AtlasSprite SpriteAtlas::GetSprite(std::string const& sourceFilePath) const
+{
+	std::map<std::string, AtlasSprite>::const_iterator spriteIter = m_sprites.find(sourceFilePath);
+	if (spriteIter != m_sprites.end())
+	{
+		return spriteIter->second;
+	}
+
+	AtlasSprite sprite;
+	sprite.m_texture = g_theRenderer->CreateOrGetTextureFromFile(sourceFilePath.c_str());
+	return sprite;
+}
+
+
+int SpriteAtlas::GetNumPages() const
+{
+	return static_cast<int>(m_pages.size());
+}
+
+
+//
+//SpriteBatch functions
+//
+void SpriteBatch::AddSprite(AABB2 const& bounds, Texture const* texture, AABB2 const& uvs, Rgba8 const& color)
+{
+	if (texture != m_texture)
+	{
+		Flush();
+		m_texture = texture;
+	}
+
+	AddVertsForAABB2(m_verts, bounds, color, uvs);
+}
+
+
+void SpriteBatch::Flush()
+{
+	if (m_verts.empty())
+	{
+		return;
+	}
+
+	g_theRenderer->BindTexture(m_texture);
+	g_theRenderer->DrawVertexArray(m_verts);
+	m_verts.clear();
+}
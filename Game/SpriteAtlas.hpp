@@ -0,0 +1,66 @@
+#pragma once
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+
+//forward declarations
+class Texture;
+
+
+//constants, shared with the offline packer (Main_AtlasPacker.cpp)
+constexpr char const* SPRITE_ATLAS_FILE_PATH = "Data/Definitions/SpriteAtlas.xml";
+constexpr char const* SPRITE_ATLAS_PAGE_FILE_FORMAT = "Data/Images/Atlas/SpriteAtlas_%i.tga";
+constexpr int SPRITE_ATLAS_PAGE_SIZE = 2048;
+constexpr int SPRITE_ATLAS_PADDING = 2;	//texels between packed sprites, filled with each sprite's edge so filtering doesn't bleed
+
+
+//where a definition's sprite ended up: a whole texture of its own, or a rect of an atlas page
+struct AtlasSprite
+{
+	Texture* m_texture = nullptr;
+	AABB2	 m_uvs = AABB2(0.0f, 0.0f, 1.0f, 1.0f);
+};
+
+
+//card art, enemy sprites and effect icons, packed offline into a few shared pages
+//definitions ask for their sprite by its source image path; sprites the atlas doesn't have (or every sprite, if the packer
+//hasn't been run) fall back to loading the source image as its own texture, so the atlas is purely an optimization
+class SpriteAtlas
+{
+//public member functions
+public:
+	//game flow functions
+	void Startup();
+
+	//accessors
+	AtlasSprite GetSprite(std::string const& sourceFilePath) const;
+	int GetNumPages() const;
+
+//private member variables
+private:
+	std::vector<Texture*>			   m_pages;
+	std::map<std::string, AtlasSprite> m_sprites;
+};
+
+
+//collects textured quads and only draws when the texture changes or it's flushed
+//sprites from the same atlas page in a row become a single draw
+class SpriteBatch
+{
+//public member functions
+public:
+	void AddSprite(AABB2 const& bounds, Texture const* texture, AABB2 const& uvs, Rgba8 const& color = Rgba8());
+	void Flush();
+
+//private member variables
+private:
+	std::vector<Vertex_PCU> m_verts;
+	Texture const*			m_texture = nullptr;
+};
+
+
+extern SpriteAtlas g_spriteAtlas;
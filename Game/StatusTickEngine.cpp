@@ -0,0 +1,79 @@
+#include "Game/StatusTickEngine.hpp"
+#include "Game/Player.hpp"
+#include "Game/Enemy.hpp"
+
+
+//
+//stack type behaviours
+//
+static bool TickDuration(Effect& effect)
+{
+	effect.m_stack -= 1;
+	return effect.m_stack > 0;
+}
+
+
+//indexed by StackType
+StackTypeRule const StatusTickEngine::s_stackTypeRules[static_cast<int>(StackType::COUNT)] =
+{
+	{ TickDuration },	//DURATION
+	{ nullptr },		//INTENSITY
+	{ nullptr },		//COUNTER
+	{ nullptr },		//NONE
+};
+
+
+//
+//public tick functions
+//
+void StatusTickEngine::TickEndOfEnemyTurn(Player* player, std::vector<Enemy*> const& enemies)
+{
+	for (int enemyIndex = 0; enemyIndex < enemies.size(); enemyIndex++)
+	{
+		Enemy* enemy = enemies[enemyIndex];
+		if (enemy != nullptr)
+		{
+			TickEffects(enemy->m_effects, enemy->m_effectTriggers, false);
+		}
+	}
+
+	//effects the enemies inflicted this turn haven't had a player turn to matter yet, so they hold for one tick
+	TickEffects(player->m_effects, player->m_effectTriggers, true);
+}
+
+
+//
+//private tick functions
+//
+void StatusTickEngine::TickEffects(std::vector<Effect>& effects, EffectTriggerLists& effectTriggers, bool holdJustAdded)
+{
+	int numKeptEffects = 0;
+
+	for (int effectIndex = 0; effectIndex < effects.size(); effectIndex++)
+	{
+		Effect& effect = effects[effectIndex];
+
+		bool isHeld = holdJustAdded && effect.m_justAdded;
+		effect.m_justAdded = false;
+
+		StackTickFunction tickFunction = s_stackTypeRules[static_cast<int>(effect.m_definition->m_stackType)].m_tickFunction;
+		bool isKept = isHeld || tickFunction == nullptr || tickFunction(effect);
+
+		//slide kept effects down over removed ones so the list stays in order without a second pass
+		if (isKept)
+		{
+			if (numKeptEffects != effectIndex)
+			{
+				effects[numKeptEffects] = effect;
+			}
+			numKeptEffects++;
+		}
+	}
+
+	//the trigger lists index into the effect list, so they only need redoing when something was compacted out
+	if (numKeptEffects != effects.size())
+	{
+		effects.erase(effects.begin() + numKeptEffects, effects.end());
+		effectTriggers.Rebuild(effects);
+	}
+}
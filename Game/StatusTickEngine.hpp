@@ -0,0 +1,39 @@
+#pragma once
+#include "Game/Effect.hpp"
+#include <vector>
+
+
+//forward declarations
+class Player;
+class Enemy;
+
+
+//what a stack type does each time its effects tick; returns false once the effect has run out and should be removed
+//per-turn triggers (damage over time and the like) go here too, the effect knows its owner
+typedef bool (*StackTickFunction)(Effect& effect);
+
+
+struct StackTypeRule
+{
+	StackTickFunction m_tickFunction = nullptr;	//nullptr means the stack is left alone
+};
+
+
+//ticks every actor's status effects at the end of the enemy turn
+//each actor's effect list is walked exactly once, dispatching on stack type through a rule table,
+//and expired effects are compacted out in place in the same pass
+class StatusTickEngine
+{
+//public member functions
+public:
+	//tick functions
+	static void TickEndOfEnemyTurn(Player* player, std::vector<Enemy*> const& enemies);
+
+//private member functions
+private:
+	static void TickEffects(std::vector<Effect>& effects, EffectTriggerLists& effectTriggers, bool holdJustAdded);
+
+//private member variables
+private:
+	static StackTypeRule const s_stackTypeRules[static_cast<int>(StackType::COUNT)];
+};